@@ -22,6 +22,10 @@
 #include "ArrowConvertorUtils.h"
 #include "BitUtils.h"
 #include "TypeConversions.h"
+#include "velox/buffer/Buffer.h"
+#include "velox/type/StringView.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::plugin {
 
@@ -196,4 +200,116 @@ void convertToArrow(ArrowArray& arrowArray,
   }
 }
 
+namespace {
+// Keeps an imported ArrowArray alive while Velox buffers reference its memory.
+class ArrowArrayReleaser {
+ public:
+  explicit ArrowArrayReleaser(std::shared_ptr<ArrowArray> array)
+      : array_(std::move(array)) {}
+
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  std::shared_ptr<ArrowArray> array_;
+};
+
+bool isStringView(const ArrowSchema* schema) {
+  return schema->format[0] == 'v' && schema->format[1] == 'u';
+}
+
+VectorPtr importStringViewAsOwner(ArrowArray& arrowArray, memory::MemoryPool* pool) {
+  auto array = std::shared_ptr<ArrowArray>(new ArrowArray(arrowArray), [](auto array) {
+    if (array->release) {
+      array->release(array);
+    }
+    delete array;
+  });
+  arrowArray.release = nullptr;
+
+  auto length = array->length;
+  auto offset = array->offset;
+  BufferPtr nulls = nullptr;
+  if (array->null_count != 0 && array->buffers[0]) {
+    nulls = AlignedBuffer::allocate<bool>(length, pool);
+    auto rawNulls = nulls->asMutable<uint64_t>();
+    auto validity = static_cast<const uint64_t*>(array->buffers[0]);
+    for (int64_t i = 0; i < length; ++i) {
+      bits::setNull(rawNulls, i, !bits::isBitSet(validity, offset + i));
+    }
+  }
+
+  // Views of inline strings have the same layout in Arrow and Velox, those of long
+  // strings reference the single data buffer by offset instead of by pointer.
+  BufferPtr values = AlignedBuffer::allocate<StringView>(length, pool);
+  auto rawValues = values->asMutable<StringView>();
+  auto views = static_cast<const int32_t*>(array->buffers[1]) + offset * 4;
+  auto data = static_cast<const char*>(array->buffers[2]);
+  for (int64_t i = 0; i < length; ++i) {
+    auto view = views + i * 4;
+    if (view[0] <= StringView::kInlineSize) {
+      rawValues[i] = StringView(reinterpret_cast<const char*>(view + 1), view[0]);
+    } else {
+      rawValues[i] = StringView(data + view[3], view[0]);
+    }
+  }
+
+  std::vector<BufferPtr> stringBuffers;
+  if (data) {
+    auto dataBytes = *static_cast<const int64_t*>(array->buffers[3]);
+    stringBuffers.emplace_back(BufferView<ArrowArrayReleaser>::create(
+        reinterpret_cast<const uint8_t*>(data), dataBytes, ArrowArrayReleaser(array)));
+  }
+  return std::make_shared<FlatVector<StringView>>(pool,
+                                                  VARCHAR(),
+                                                  nulls,
+                                                  length,
+                                                  values,
+                                                  std::move(stringBuffers));
+}
+}  // namespace
+
+RowVectorPtr importFromCiderArrowAsOwner(ArrowSchema& arrowSchema,
+                                         ArrowArray& arrowArray,
+                                         memory::MemoryPool* pool) {
+  bool hasStringView = false;
+  for (int64_t i = 0; i < arrowSchema.n_children; ++i) {
+    hasStringView |= isStringView(arrowSchema.children[i]);
+  }
+  if (!hasStringView) {
+    return std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool));
+  }
+
+  // Columns are moved out of the batch and imported one by one.
+  VELOX_CHECK_EQ(arrowArray.offset, 0);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> children;
+  for (int64_t i = 0; i < arrowSchema.n_children; ++i) {
+    auto childSchema = arrowSchema.children[i];
+    auto childArray = arrowArray.children[i];
+    names.emplace_back(childSchema->name ? childSchema->name : "");
+    if (isStringView(childSchema)) {
+      children.emplace_back(importStringViewAsOwner(*childArray, pool));
+    } else {
+      ArrowSchema schema = *childSchema;
+      ArrowArray array = *childArray;
+      childSchema->release = nullptr;
+      childArray->release = nullptr;
+      children.emplace_back(importFromArrowAsOwner(schema, array, pool));
+    }
+    types.emplace_back(children.back()->type());
+  }
+  auto length = arrowArray.length;
+  arrowArray.release(&arrowArray);
+  arrowSchema.release(&arrowSchema);
+
+  return std::make_shared<RowVector>(pool,
+                                     ROW(std::move(names), std::move(types)),
+                                     BufferPtr(nullptr),
+                                     length,
+                                     std::move(children));
+}
+
 }  // namespace facebook::velox::plugin
@@ -26,6 +26,7 @@
 #include <string>
 #include "CiderNullValues.h"
 #include "cider/CiderInterface.h"
+#include "velox/vector/ComplexVector.h"
 #include "velox/vector/arrow/Abi.h"
 
 namespace {
@@ -55,4 +56,12 @@ void convertToArrow(ArrowArray& arrowArray,
                     int num_rows,
                     memory::MemoryPool* pool);
 
+/// Import a Cider output batch as a RowVector and take the ownership of it like
+/// importFromArrowAsOwner. Utf8View ("vu") columns, which are not supported by the
+/// Velox Arrow bridge, are imported as FlatVector<StringView> whose long strings point
+/// into the Cider data buffer, so string data is not copied.
+RowVectorPtr importFromCiderArrowAsOwner(ArrowSchema& arrowSchema,
+                                         ArrowArray& arrowArray,
+                                         memory::MemoryPool* pool);
+
 }  // namespace facebook::velox::plugin
@@ -21,8 +21,10 @@
 
 #include "CiderPipelineOperator.h"
 #include "Allocator.h"
+#include "ArrowConvertorUtils.h"
 #include "CiderCrossJoinBuild.h"
 #include "CiderHashJoinBuild.h"
+#include "CiderVeloxOptions.h"
 #include "exec/plan/substrait/SubstraitPlan.h"
 #include "velox/exec/Task.h"
 #ifndef CIDER_BATCH_PROCESSOR_CONTEXT_H
@@ -33,7 +35,8 @@
 namespace facebook::velox::plugin {
 
 bool CiderPipelineOperator::needsInput() const {
-  return !finished_;
+  // Output of last input is bounded and not fully fetched yet.
+  return !finished_ && !batchProcessor_->hasPendingOutput();
 }
 
 void CiderPipelineOperator::addInput(RowVectorPtr input) {
@@ -77,8 +80,7 @@ facebook::velox::RowVectorPtr CiderPipelineOperator::getOutput() {
 
   batchProcessor_->getResult(array, schema);
   if (array.length) {
-    VectorPtr baseVec = importFromArrowAsOwner(schema, array, operatorCtx_->pool());
-    return std::reinterpret_pointer_cast<RowVector>(baseVec);
+    return importFromCiderArrowAsOwner(schema, array, operatorCtx_->pool());
   }
   return nullptr;
 }
@@ -119,7 +121,21 @@ CiderPipelineOperator::CiderPipelineOperator(
     context->setHashBuildTableSupplier(buildTableSupplier);
   }
 
-  batchProcessor_ = cider::exec::processor::makeBatchProcessor(substraitPlan, context);
+  // Stop generated loops promptly once the task is aborted, cancelled or failed.
+  context->setInterruptChecker(
+      [task = operatorCtx_->task().get()]() { return !task->isRunning(); });
+
+  // Small batches (e.g. output of selective filters) are coalesced ahead of the query
+  // function to amortize its per-batch cost.
+  context->setMinInputRows(FLAGS_cider_min_input_rows);
+  context->setMaxInputDelay(std::chrono::milliseconds(FLAGS_cider_max_input_delay_ms));
+
+  // Varchar output is handed over as string views instead of offsets and data.
+  cider::exec::nextgen::context::CodegenOptions codegenOptions;
+  codegenOptions.string_view_output = FLAGS_cider_string_view_output;
+
+  batchProcessor_ = cider::exec::processor::makeBatchProcessor(
+      substraitPlan, context, codegenOptions);
 }
 
 }  // namespace facebook::velox::plugin
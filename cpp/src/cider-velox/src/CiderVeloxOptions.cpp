@@ -22,3 +22,15 @@
 #include "CiderVeloxOptions.h"
 
 DEFINE_bool(enable_batch_processor, false, "Enable Cider Velox to use BatchProcessor");
+DEFINE_int64(cider_min_input_rows,
+             0,
+             "Smaller input batches of BatchProcessor are coalesced up to this number of "
+             "rows, 0 disables coalescing");
+DEFINE_int64(cider_max_input_delay_ms,
+             0,
+             "Maximum time coalesced input of BatchProcessor is buffered, 0 means no "
+             "limit");
+DEFINE_bool(cider_string_view_output,
+            false,
+            "Output varchar columns of BatchProcessor as Arrow string views, which are "
+            "imported to Velox without copying string data");
@@ -23,3 +23,6 @@
 #include <gflags/gflags.h>
 
 DECLARE_bool(enable_batch_processor);
+DECLARE_int64(cider_min_input_rows);
+DECLARE_int64(cider_max_input_delay_ms);
+DECLARE_bool(cider_string_view_output);
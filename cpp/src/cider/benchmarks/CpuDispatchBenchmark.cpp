@@ -0,0 +1,146 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "util/CiderCpuDispatch.h"
+
+using namespace CiderCpuDispatch;
+
+namespace {
+
+constexpr int64_t kSpeedupRepeats = 64;
+
+// Measures `kernel` with both the baseline and the target kernels and reports the
+// ratio of their elapsed time as the speedup of target over baseline.
+template <typename Kernel>
+void reportSpeedup(benchmark::State& state, IsaLevel level, Kernel&& kernel) {
+  auto measure = [&kernel](const Kernels& kernels) {
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < kSpeedupRepeats; ++i) {
+      kernel(kernels);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+        .count();
+  };
+  double baseline = measure(getKernels(IsaLevel::kBaseline));
+  double target = measure(getKernels(level));
+  state.counters["speedup"] = target > 0 ? baseline / target : 0;
+}
+
+bool skipUnsupported(benchmark::State& state, IsaLevel level) {
+  if (level > getHostIsaLevel()) {
+    state.SkipWithError("ISA level is not supported by host");
+    return true;
+  }
+  return false;
+}
+
+std::vector<uint8_t> randomBytes(size_t num) {
+  std::mt19937 rng(42);
+  std::vector<uint8_t> bytes(num);
+  for (auto& byte : bytes) {
+    byte = rng();
+  }
+  return bytes;
+}
+
+void countSetBitsBenchmark(benchmark::State& state, IsaLevel level) {
+  if (skipUnsupported(state, level)) {
+    return;
+  }
+  size_t bit_num = state.range(0);
+  auto bits = randomBytes(bit_num / 8);
+  auto kernel = [&](const Kernels& kernels) {
+    benchmark::DoNotOptimize(kernels.count_set_bits(bits.data(), bit_num));
+  };
+  for (auto _ : state) {
+    kernel(getKernels(level));
+  }
+  state.SetBytesProcessed(state.iterations() * bits.size());
+  reportSpeedup(state, level, kernel);
+}
+
+void bitwiseAndBenchmark(benchmark::State& state, IsaLevel level) {
+  if (skipUnsupported(state, level)) {
+    return;
+  }
+  size_t bit_num = state.range(0);
+  auto a = randomBytes(bit_num / 8);
+  auto b = randomBytes(bit_num / 8);
+  std::vector<uint8_t> output(bit_num / 8);
+  auto kernel = [&](const Kernels& kernels) {
+    kernels.bitwise_and(output.data(), a.data(), b.data(), bit_num);
+    benchmark::ClobberMemory();
+  };
+  for (auto _ : state) {
+    kernel(getKernels(level));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * 2);
+  reportSpeedup(state, level, kernel);
+}
+
+void findStrBenchmark(benchmark::State& state, IsaLevel level) {
+  if (skipUnsupported(state, level)) {
+    return;
+  }
+  // Pattern is placed at the end of a log-like line and its first byte occurs
+  // frequently, so single byte filtering yields many false candidates.
+  std::string str;
+  while (str.size() < static_cast<size_t>(state.range(0))) {
+    str += "GET /api/v1/items?id=12345 HTTP/1.1 200 ";
+  }
+  const std::string pattern = "items?id=99999";
+  str += pattern;
+  auto kernel = [&](const Kernels& kernels) {
+    benchmark::DoNotOptimize(
+        kernels.find_str(str.data(), str.size(), pattern.data(), pattern.size()));
+  };
+  for (auto _ : state) {
+    kernel(getKernels(level));
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+  reportSpeedup(state, level, kernel);
+}
+
+}  // namespace
+
+#define CPU_DISPATCH_BENCHMARK(KERNEL, LEVEL, RANGE) \
+  BENCHMARK_CAPTURE(KERNEL##Benchmark, LEVEL, IsaLevel::k##LEVEL)->Arg(RANGE);
+
+#define CPU_DISPATCH_BENCHMARKS(KERNEL, RANGE)    \
+  CPU_DISPATCH_BENCHMARK(KERNEL, Baseline, RANGE) \
+  CPU_DISPATCH_BENCHMARK(KERNEL, AVX2, RANGE)     \
+  CPU_DISPATCH_BENCHMARK(KERNEL, AVX512, RANGE)
+
+CPU_DISPATCH_BENCHMARKS(countSetBits, 1 << 20)
+CPU_DISPATCH_BENCHMARKS(bitwiseAnd, 1 << 20)
+CPU_DISPATCH_BENCHMARKS(findStr, 1 << 12)
+
+#undef CPU_DISPATCH_BENCHMARKS
+#undef CPU_DISPATCH_BENCHMARK
+
+BENCHMARK_MAIN();
@@ -31,6 +31,7 @@ CiderArrowArrayBufferHolder::CiderArrowArrayBufferHolder(
     bool dict)
     : buffers_(buffer_num, nullptr)
     , buffers_bytes_(buffer_num, 0)
+    , buffers_owner_(buffer_num)
     , children_ptr_(children_num, nullptr)
     , children_and_dict_(children_num + (dict ? 1 : 0))
     , allocator_(allocator)
@@ -55,6 +56,10 @@ size_t CiderArrowArrayBufferHolder::getBufferSizeAt(size_t index) {
 }
 
 void CiderArrowArrayBufferHolder::allocBuffer(size_t index, size_t bytes) {
+  if (buffers_owner_[index]) {
+    // Shared memory is read-only, allocate a buffer of our own.
+    releaseBuffer(index);
+  }
   if (buffers_[index]) {
     if (bytes > buffers_bytes_[index]) {
       buffers_[index] = allocator_->reallocate(
@@ -68,7 +73,20 @@ void CiderArrowArrayBufferHolder::allocBuffer(size_t index, size_t bytes) {
   }
 }
 
+void CiderArrowArrayBufferHolder::shareBuffer(size_t index,
+                                              const void* buffer,
+                                              std::shared_ptr<const void> owner) {
+  releaseBuffer(index);
+  buffers_[index] = const_cast<void*>(buffer);
+  buffers_owner_[index] = std::move(owner);
+}
+
 void CiderArrowArrayBufferHolder::releaseBuffer(size_t index) {
+  if (buffers_owner_[index]) {
+    buffers_owner_[index].reset();
+    buffers_[index] = nullptr;
+    return;
+  }
   if (buffers_[index]) {
     allocator_->deallocate(reinterpret_cast<int8_t*>(buffers_[index]),
                            buffers_bytes_[index]);
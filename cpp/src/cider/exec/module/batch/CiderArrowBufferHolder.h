@@ -22,6 +22,7 @@
 #ifndef CIDER_ARROW_BUFFER_HOLDER_H
 #define CIDER_ARROW_BUFFER_HOLDER_H
 
+#include <memory>
 #include <vector>
 
 #include "cider/CiderAllocator.h"
@@ -47,6 +48,10 @@ class CiderArrowArrayBufferHolder {
   // (re-) Allocate the buffer.
   void allocBuffer(size_t index, size_t bytes);
 
+  // Points the buffer to memory of another array instead of owning a copy, owner is
+  // kept alive until the buffer is released or re-allocated.
+  void shareBuffer(size_t index, const void* buffer, std::shared_ptr<const void> owner);
+
   ArrowArray** getChildrenPtrs() { return children_ptr_.data(); }
 
   ArrowArray* getDictPtr();
@@ -58,6 +63,7 @@ class CiderArrowArrayBufferHolder {
 
   std::vector<void*> buffers_;
   std::vector<size_t> buffers_bytes_;  // Used for allocator.
+  std::vector<std::shared_ptr<const void>> buffers_owner_;  // Set if buffer is shared.
   std::vector<ArrowArray*> children_ptr_;
   std::vector<ArrowArray> children_and_dict_;
   std::shared_ptr<CiderAllocator> allocator_;
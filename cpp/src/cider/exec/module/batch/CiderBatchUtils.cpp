@@ -155,6 +155,9 @@ int64_t getBufferNum(const ArrowSchema* schema) {
       }
     case 'u':
       return 3;
+    case 'v':
+      // validity, views, a single variadic data buffer and its size.
+      return 4;
     default:
       CIDER_THROW(CiderException,
                   std::string("Unsupported data type to CiderBatch: ") + type);
@@ -189,6 +192,7 @@ SQLTypes convertArrowTypeToCiderType(const char* format) {
           return kSTRUCT;
       }
     case 'u':
+    case 'v':
       return kVARCHAR;
     case 't':
       // date32 [days]
@@ -342,6 +346,15 @@ ArrowSchema* convertCiderTableSchemaToArrowSchema(const CiderTableSchema& table)
 }
 
 std::string extractUtf8ArrowArrayAt(const ArrowArray* array, size_t index) {
+  if (array->n_buffers == 4) {
+    // Utf8View, strings longer than 12 bytes are kept in the data buffer.
+    auto view = reinterpret_cast<const int32_t*>(array->buffers[1]) + index * 4;
+    if (view[0] <= 12) {
+      return std::string(reinterpret_cast<const char*>(view + 1), view[0]);
+    }
+    auto data = reinterpret_cast<const char*>(array->buffers[2 + view[2]]);
+    return std::string(data + view[3], view[0]);
+  }
   const char* str = (const char*)(array->buffers[2]);
   int32_t* offsets = (int32_t*)(array->buffers[1]);
 
@@ -20,20 +20,34 @@
  */
 #include "exec/nextgen/context/Batch.h"
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <vector>
 
+#include "cider/CiderException.h"
 #include "exec/module/batch/ArrowABI.h"
 #include "exec/module/batch/CiderArrowBufferHolder.h"
 #include "exec/nextgen/utils/FunctorUtils.h"
+#include "util/CiderBitUtils.h"
 
 namespace cider::exec::nextgen::context {
 
-void Batch::reset(const SQLTypeInfo& type, const CiderAllocatorPtr& allocator) {
+void Batch::reset(const SQLTypeInfo& type,
+                  const CiderAllocatorPtr& allocator,
+                  bool string_view) {
   release();
 
   auto schema = CiderBatchUtils::convertCiderTypeInfoToArrowSchema(type);
   schema_ = *schema;
   CiderBatchUtils::freeArrowSchema(schema);
+  if (string_view) {
+    for (int64_t i = 0; i < schema_.n_children; ++i) {
+      if (std::string_view(schema_.children[i]->format) == "u") {
+        schema_.children[i]->format = "vu";
+      }
+    }
+  }
 
   auto builder = utils::RecursiveFunctor{
       [&allocator](auto&& builder, ArrowSchema* schema, ArrowArray* array) -> void {
@@ -58,4 +72,467 @@ void Batch::reset(const SQLTypeInfo& type, const CiderAllocatorPtr& allocator) {
 
   builder(&schema_, &array_);
 }
+
+namespace batch_runtime_utils {
+namespace {
+template <typename T>
+void gatherValues(T* __restrict output,
+                  const T* __restrict input,
+                  const int32_t* selection,
+                  int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    output[i] = input[selection[i]];
+  }
+}
+
+void gatherBits(uint8_t* output,
+                const uint8_t* input,
+                int64_t input_offset,
+                const int32_t* selection,
+                int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    auto row = (selection ? selection[i] : i) + input_offset;
+    if (CiderBitUtils::isBitSetAt(input, row)) {
+      CiderBitUtils::setBitAt(output, i);
+    } else {
+      CiderBitUtils::clearBitAt(output, i);
+    }
+  }
+}
+
+void gatherFlatArrowArray(ArrowArray* output,
+                          const ArrowArray* input,
+                          int64_t value_bytes,
+                          const int32_t* selection,
+                          int64_t count) {
+  auto holder = reinterpret_cast<CiderArrowArrayBufferHolder*>(output->private_data);
+  auto offset = input->offset;
+  auto bitmap_bytes = (count + 7) / 8;
+
+  if (input->buffers[0]) {
+    holder->allocBuffer(0, bitmap_bytes);
+    gatherBits(holder->getBufferAs<uint8_t>(0),
+               reinterpret_cast<const uint8_t*>(input->buffers[0]),
+               offset,
+               selection,
+               count);
+  } else if (output->buffers[0]) {
+    holder->allocBuffer(0, bitmap_bytes);
+    memset(holder->getBufferAs<uint8_t>(0), 0xFF, bitmap_bytes);
+  }
+
+  if (input->n_buffers == 3) {
+    auto input_offsets = reinterpret_cast<const int32_t*>(input->buffers[1]) + offset;
+    auto input_data = reinterpret_cast<const int8_t*>(input->buffers[2]);
+    holder->allocBuffer(1, (count + 1) * sizeof(int32_t));
+    auto output_offsets = holder->getBufferAs<int32_t>(1);
+    output_offsets[0] = 0;
+    for (int64_t i = 0; i < count; ++i) {
+      auto row = selection ? selection[i] : i;
+      output_offsets[i + 1] =
+          output_offsets[i] + input_offsets[row + 1] - input_offsets[row];
+    }
+    holder->allocBuffer(2, std::max(output_offsets[count], 1));
+    auto output_data = holder->getBufferAs<int8_t>(2);
+    if (!selection) {
+      memcpy(output_data, input_data + input_offsets[0], output_offsets[count]);
+    } else {
+      for (int64_t i = 0; i < count; ++i) {
+        auto row = selection[i];
+        memcpy(output_data + output_offsets[i],
+               input_data + input_offsets[row],
+               input_offsets[row + 1] - input_offsets[row]);
+      }
+    }
+  } else if (value_bytes < 0) {
+    CIDER_THROW(CiderUnsupportedException,
+                "Only flat fixed-size and varchar columns can be concatenated");
+  } else if (value_bytes == 0) {
+    holder->allocBuffer(1, bitmap_bytes);
+    gatherBits(holder->getBufferAs<uint8_t>(1),
+               reinterpret_cast<const uint8_t*>(input->buffers[1]),
+               offset,
+               selection,
+               count);
+  } else {
+    holder->allocBuffer(1, count * value_bytes);
+    auto input_data =
+        reinterpret_cast<const int8_t*>(input->buffers[1]) + offset * value_bytes;
+    auto output_data = holder->getBufferAs<int8_t>(1);
+    if (!selection) {
+      memcpy(output_data, input_data, count * value_bytes);
+    } else {
+      switch (value_bytes) {
+        case 1:
+          gatherValues(output_data, input_data, selection, count);
+          break;
+        case 2:
+          gatherValues(reinterpret_cast<int16_t*>(output_data),
+                       reinterpret_cast<const int16_t*>(input_data),
+                       selection,
+                       count);
+          break;
+        case 4:
+          gatherValues(reinterpret_cast<int32_t*>(output_data),
+                       reinterpret_cast<const int32_t*>(input_data),
+                       selection,
+                       count);
+          break;
+        case 8:
+          gatherValues(reinterpret_cast<int64_t*>(output_data),
+                       reinterpret_cast<const int64_t*>(input_data),
+                       selection,
+                       count);
+          break;
+        default:
+          for (int64_t i = 0; i < count; ++i) {
+            memcpy(output_data + i * value_bytes,
+                   input_data + selection[i] * value_bytes,
+                   value_bytes);
+          }
+      }
+    }
+  }
+
+  output->length = count;
+  output->offset = 0;
+}
+}  // namespace
+
+ArrowArrayEncoding getArrowArrayEncoding(const ArrowArray* array) {
+  if (array->dictionary) {
+    return ArrowArrayEncoding::kDictionary;
+  }
+  // Input columns are never nested, a buffer-less array with run ends and values
+  // children is run-end encoded.
+  if (array->n_buffers == 0 && array->n_children == 2) {
+    return ArrowArrayEncoding::kRunEnd;
+  }
+  if (array->length == 1) {
+    return ArrowArrayEncoding::kConstant;
+  }
+  return ArrowArrayEncoding::kFlat;
+}
+
+const ArrowArray* getArrowArrayValues(const ArrowArray* array) {
+  switch (getArrowArrayEncoding(array)) {
+    case ArrowArrayEncoding::kDictionary:
+      return array->dictionary;
+    case ArrowArrayEncoding::kRunEnd:
+      return array->children[1];
+    default:
+      return array;
+  }
+}
+
+void decodeRunEnds(const ArrowArray* array, int32_t* value_indices, int64_t len) {
+  auto run_ends_array = array->children[0];
+  auto run_ends = reinterpret_cast<const int32_t*>(run_ends_array->buffers[1]) +
+                  run_ends_array->offset;
+  auto run_num = run_ends_array->length;
+  // Run ends are logical positions, which include the offset of the array.
+  int64_t position = array->offset;
+  int64_t run = std::upper_bound(run_ends, run_ends + run_num, position) - run_ends;
+  for (int64_t i = 0; i < len; ++i, ++position) {
+    while (run_ends[run] <= position) {
+      ++run;
+    }
+    value_indices[i] = run;
+  }
+}
+
+void decodeValidity(const ArrowArray* array, uint8_t* validity, int64_t len) {
+  auto values = getArrowArrayValues(array);
+  auto value_validity = reinterpret_cast<const uint8_t*>(values->buffers[0]);
+  if (getArrowArrayEncoding(array) != ArrowArrayEncoding::kRunEnd) {
+    std::memset(validity,
+                CiderBitUtils::isBitSetAt(value_validity, values->offset) ? 0xFF : 0,
+                (len + 7) / 8);
+    return;
+  }
+  std::vector<int32_t> value_indices(len);
+  decodeRunEnds(array, value_indices.data(), len);
+  gatherBits(validity, value_validity, values->offset, value_indices.data(), len);
+}
+
+void gatherArrowArray(ArrowArray* output,
+                      const ArrowArray* input,
+                      int64_t value_bytes,
+                      const int32_t* selection,
+                      int64_t count) {
+  auto encoding = getArrowArrayEncoding(input);
+  if (encoding == ArrowArrayEncoding::kFlat) {
+    gatherFlatArrowArray(output, input, value_bytes, selection, count);
+    return;
+  }
+
+  // Rows of encoded input are gathered from its values.
+  std::vector<int32_t> value_indices(count, 0);
+  if (encoding == ArrowArrayEncoding::kDictionary) {
+    auto indices = reinterpret_cast<const int32_t*>(input->buffers[1]) + input->offset;
+    for (int64_t i = 0; i < count; ++i) {
+      value_indices[i] = indices[selection ? selection[i] : i];
+    }
+  } else if (encoding == ArrowArrayEncoding::kRunEnd && count > 0) {
+    std::vector<int32_t> run_indices(selection ? selection[count - 1] + 1 : count);
+    decodeRunEnds(input, run_indices.data(), run_indices.size());
+    for (int64_t i = 0; i < count; ++i) {
+      value_indices[i] = run_indices[selection ? selection[i] : i];
+    }
+  }
+  gatherFlatArrowArray(
+      output, getArrowArrayValues(input), value_bytes, value_indices.data(), count);
+
+  if (encoding == ArrowArrayEncoding::kDictionary && input->buffers[0]) {
+    auto holder = reinterpret_cast<CiderArrowArrayBufferHolder*>(output->private_data);
+    holder->allocBuffer(0, (count + 7) / 8);
+    gatherBits(holder->getBufferAs<uint8_t>(0),
+               reinterpret_cast<const uint8_t*>(input->buffers[0]),
+               input->offset,
+               selection,
+               count);
+  }
+}
+
+int64_t getArrowFormatValueBytes(std::string_view format) {
+  if (format.size() == 1) {
+    switch (format[0]) {
+      case 'b':
+        return 0;
+      case 'c':
+      case 'C':
+        return 1;
+      case 's':
+      case 'S':
+      case 'e':
+        return 2;
+      case 'i':
+      case 'I':
+      case 'f':
+        return 4;
+      case 'l':
+      case 'L':
+      case 'g':
+        return 8;
+      default:
+        return -1;
+    }
+  }
+  if (format[0] == 'd' && format[1] == ':') {
+    return 16;
+  }
+  if (format == "tdD" || format == "tts" || format == "ttm" || format == "tiM") {
+    return 4;
+  }
+  if (format == "tdm" || format == "ttu" || format == "ttn" || format == "tiD" ||
+      format.substr(0, 2) == "ts" || format.substr(0, 2) == "tD") {
+    return 8;
+  }
+  if (format == "tin") {
+    return 16;
+  }
+  return -1;
+}
+
+bool sliceArrowArray(ArrowArraySlice& slice,
+                     const ArrowArray* input,
+                     const ArrowSchema* schema,
+                     int64_t begin,
+                     int64_t len) {
+  auto n_children = input->n_children;
+  slice.array = *input;
+  slice.array.length = len;
+  slice.array.offset = 0;
+  slice.array.null_count = input->null_count ? -1 : 0;
+  slice.array.release = nullptr;
+  slice.array.private_data = nullptr;
+  slice.children.resize(n_children);
+  for (int64_t i = 0; i < n_children; ++i) {
+    slice.children[i] = *input->children[i];
+  }
+  slice.children_ptrs.resize(n_children);
+  slice.buffers.assign(n_children, {nullptr, nullptr, nullptr});
+  slice.array.children = slice.children_ptrs.data();
+
+  for (int64_t i = 0; i < n_children; ++i) {
+    auto& child = slice.children[i];
+    auto& buffers = slice.buffers[i];
+    slice.children_ptrs[i] = &child;
+    // First row of the slice in the buffers of the column, bitmaps can only be shifted
+    // by whole bytes.
+    int64_t start = input->offset + child.offset + begin;
+    auto shift_bits = [start](const void* buffer) -> const void* {
+      return buffer ? reinterpret_cast<const uint8_t*>(buffer) + start / 8 : nullptr;
+    };
+    auto shift_values = [start](const void* buffer,
+                                int64_t value_bytes) -> const void* {
+      return reinterpret_cast<const int8_t*>(buffer) + start * value_bytes;
+    };
+    auto encoding = getArrowArrayEncoding(&child);
+    if (encoding == ArrowArrayEncoding::kConstant) {
+      continue;
+    }
+    if (encoding != ArrowArrayEncoding::kRunEnd && start % 8 != 0) {
+      return false;
+    }
+    switch (encoding) {
+      case ArrowArrayEncoding::kConstant:
+        break;
+      case ArrowArrayEncoding::kRunEnd:
+        // Run ends are logical positions, they are sliced by the array offset.
+        child.offset = start;
+        break;
+      case ArrowArrayEncoding::kDictionary:
+        child.offset = 0;
+        buffers[0] = shift_bits(child.buffers[0]);
+        buffers[1] = shift_values(child.buffers[1], sizeof(int32_t));
+        break;
+      case ArrowArrayEncoding::kFlat: {
+        if (child.n_children > 0 || child.n_buffers > 3) {
+          return false;
+        }
+        std::copy(child.buffers, child.buffers + child.n_buffers, buffers.begin());
+        child.offset = 0;
+        buffers[0] = shift_bits(child.buffers[0]);
+        if (child.n_buffers == 3) {
+          // Offsets index the data buffer, which is shared as it is.
+          buffers[1] = shift_values(child.buffers[1], sizeof(int32_t));
+          break;
+        }
+        auto value_bytes = getArrowFormatValueBytes(schema->children[i]->format);
+        if (value_bytes < 0) {
+          return false;
+        }
+        buffers[1] = value_bytes ? shift_values(child.buffers[1], value_bytes)
+                                 : shift_bits(child.buffers[1]);
+        break;
+      }
+    }
+    if (child.n_buffers > 0) {
+      child.buffers = buffers.data();
+    }
+    child.length = len;
+    child.null_count = child.null_count ? -1 : 0;
+    child.release = nullptr;
+    child.private_data = nullptr;
+  }
+  return true;
+}
+
+void concatArrowArrays(ArrowArray* output,
+                       const std::vector<const ArrowArray*>& inputs,
+                       int64_t value_bytes) {
+  auto holder = reinterpret_cast<CiderArrowArrayBufferHolder*>(output->private_data);
+  int64_t length = 0;
+  bool has_validity = false;
+  for (auto input : inputs) {
+    length += input->length;
+    has_validity |= input->buffers[0] != nullptr;
+  }
+  auto bitmap_bytes = (length + 7) / 8;
+
+  // Missing input bits are taken as set.
+  auto append_bits = [](uint8_t* output_bits,
+                        int64_t output_offset,
+                        const ArrowArray* input,
+                        const void* input_bits) {
+    auto bits = reinterpret_cast<const uint8_t*>(input_bits);
+    for (int64_t i = 0; i < input->length; ++i) {
+      if (!bits || CiderBitUtils::isBitSetAt(bits, input->offset + i)) {
+        CiderBitUtils::setBitAt(output_bits, output_offset + i);
+      } else {
+        CiderBitUtils::clearBitAt(output_bits, output_offset + i);
+      }
+    }
+  };
+
+  if (has_validity) {
+    holder->allocBuffer(0, bitmap_bytes);
+    int64_t row = 0;
+    for (auto input : inputs) {
+      append_bits(holder->getBufferAs<uint8_t>(0), row, input, input->buffers[0]);
+      row += input->length;
+    }
+  }
+
+  if (output->n_buffers == 3) {
+    int64_t data_bytes = 0;
+    for (auto input : inputs) {
+      auto offsets = reinterpret_cast<const int32_t*>(input->buffers[1]) + input->offset;
+      data_bytes += offsets[input->length] - offsets[0];
+    }
+    holder->allocBuffer(1, (length + 1) * sizeof(int32_t));
+    holder->allocBuffer(2, std::max<int64_t>(data_bytes, 1));
+    auto output_offsets = holder->getBufferAs<int32_t>(1);
+    auto output_data = holder->getBufferAs<int8_t>(2);
+    output_offsets[0] = 0;
+    int64_t row = 0;
+    for (auto input : inputs) {
+      auto offsets = reinterpret_cast<const int32_t*>(input->buffers[1]) + input->offset;
+      auto data = reinterpret_cast<const int8_t*>(input->buffers[2]);
+      memcpy(output_data + output_offsets[row],
+             data + offsets[0],
+             offsets[input->length] - offsets[0]);
+      for (int64_t i = 0; i < input->length; ++i) {
+        output_offsets[row + i + 1] = output_offsets[row] + offsets[i + 1] - offsets[0];
+      }
+      row += input->length;
+    }
+  } else if (output->n_buffers == 4) {
+    // Utf8View with a single data buffer, views of long strings are rebased.
+    auto get_data_bytes = [](const ArrowArray* input) -> int64_t {
+      return input->buffers[3] ? *reinterpret_cast<const int64_t*>(input->buffers[3]) : 0;
+    };
+    int64_t data_bytes = 0;
+    for (auto input : inputs) {
+      data_bytes += get_data_bytes(input);
+    }
+    holder->allocBuffer(1, std::max<int64_t>(length * 16, 1));
+    holder->allocBuffer(2, std::max<int64_t>(data_bytes, 1));
+    holder->allocBuffer(3, sizeof(int64_t));
+    *holder->getBufferAs<int64_t>(3) = data_bytes;
+    auto output_views = holder->getBufferAs<int32_t>(1);
+    auto output_data = holder->getBufferAs<int8_t>(2);
+    int64_t data_offset = 0;
+    for (auto input : inputs) {
+      auto views =
+          reinterpret_cast<const int32_t*>(input->buffers[1]) + input->offset * 4;
+      memcpy(output_views, views, input->length * 16);
+      auto input_data_bytes = get_data_bytes(input);
+      if (input_data_bytes) {
+        memcpy(output_data + data_offset, input->buffers[2], input_data_bytes);
+        for (int64_t i = 0; i < input->length; ++i) {
+          if (output_views[i * 4] > 12) {
+            output_views[i * 4 + 3] += data_offset;
+          }
+        }
+      }
+      output_views += input->length * 4;
+      data_offset += input_data_bytes;
+    }
+  } else if (value_bytes < 0) {
+    CIDER_THROW(CiderUnsupportedException,
+                "Only flat fixed-size and varchar columns can be concatenated");
+  } else if (value_bytes == 0) {
+    holder->allocBuffer(1, bitmap_bytes);
+    int64_t row = 0;
+    for (auto input : inputs) {
+      append_bits(holder->getBufferAs<uint8_t>(1), row, input, input->buffers[1]);
+      row += input->length;
+    }
+  } else {
+    holder->allocBuffer(1, std::max<int64_t>(length * value_bytes, 1));
+    auto output_data = holder->getBufferAs<int8_t>(1);
+    for (auto input : inputs) {
+      auto input_data = reinterpret_cast<const int8_t*>(input->buffers[1]);
+      auto bytes = input->length * value_bytes;
+      memcpy(output_data, input_data + input->offset * value_bytes, bytes);
+      output_data += bytes;
+    }
+  }
+
+  output->length = length;
+  output->offset = 0;
+}
+}  // namespace batch_runtime_utils
 }  // namespace cider::exec::nextgen::context
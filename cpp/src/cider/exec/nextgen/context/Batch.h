@@ -21,23 +21,33 @@
 #ifndef NEXTGEN_CONTEXT_BATCH_H
 #define NEXTGEN_CONTEXT_BATCH_H
 
+#include <array>
+#include <string_view>
+#include <vector>
+
 #include "exec/module/batch/ArrowABI.h"
 #include "include/cider/batch/CiderBatchUtils.h"
 
 namespace cider::exec::nextgen::context {
 class Batch {
  public:
-  Batch(const SQLTypeInfo& type, const CiderAllocatorPtr& allocator) {
+  Batch(const SQLTypeInfo& type,
+        const CiderAllocatorPtr& allocator,
+        bool string_view = false) {
     schema_.release = nullptr;
     array_.release = nullptr;
-    reset(type, allocator);
+    reset(type, allocator, string_view);
   }
 
   Batch(ArrowSchema& schema, ArrowArray& array) : schema_(schema), array_(array) {}
 
   ~Batch() { release(); }
 
-  void reset(const SQLTypeInfo& type, const CiderAllocatorPtr& allocator);
+  // Varchar columns use Utf8View layout ("vu") if string_view, offsets and data ("u")
+  // otherwise.
+  void reset(const SQLTypeInfo& type,
+             const CiderAllocatorPtr& allocator,
+             bool string_view = false);
 
   void move(ArrowSchema& schema, ArrowArray& array) {
     schema = schema_;
@@ -73,6 +83,69 @@ using BatchPtr = std::unique_ptr<Batch>;
 
 namespace batch_runtime_utils {
 // void resizeBatch(Batch* batch, size_t size);
-}
+
+// Layouts of input columns. Dictionary indices and run ends are INT32, a constant
+// column is a flat array of length 1 whose value applies to every row of the batch.
+enum class ArrowArrayEncoding : int32_t {
+  kFlat = 0,
+  kDictionary = 1,
+  kRunEnd = 2,
+  kConstant = 3,
+};
+
+ArrowArrayEncoding getArrowArrayEncoding(const ArrowArray* array);
+
+// Returns the array holding values of an encoded array. Validity of rows is held by the
+// values as well, except for dictionary-encoded arrays whose indices hold it.
+const ArrowArray* getArrowArrayValues(const ArrowArray* array);
+
+// Writes the run index of rows [0, len) of a run-end encoded array.
+void decodeRunEnds(const ArrowArray* array, int32_t* value_indices, int64_t len);
+
+// Writes validity bits of rows [0, len) of a run-end encoded or constant array from the
+// validity of its values, which must not be null.
+void decodeValidity(const ArrowArray* array, uint8_t* validity, int64_t len);
+
+// Copies rows selection[0, count) of an input column into an output column allocated
+// by CiderArrowArrayBufferHolder, all rows are copied if selection is null. Input
+// may be encoded, output is always flat.
+// value_bytes is the width of fixed-size values, 0 for bit-packed booleans, and is
+// ignored for variable-size columns.
+void gatherArrowArray(ArrowArray* output,
+                      const ArrowArray* input,
+                      int64_t value_bytes,
+                      const int32_t* selection,
+                      int64_t count);
+
+// Returns the width of fixed-size values of an Arrow format, 0 for bit-packed booleans
+// and -1 for variable-size and nested types.
+int64_t getArrowFormatValueBytes(std::string_view format);
+
+// Rows [begin, begin + len) of an input batch, buffers are shared with the input batch
+// which has to outlive the slice.
+struct ArrowArraySlice {
+  ArrowArray array;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> children_ptrs;
+  std::vector<std::array<const void*, 3>> buffers;
+};
+
+// Slices an input batch by shifting buffer pointers of its columns, so the first row of
+// the slice (including the offsets of the batch and the column) has to be a multiple
+// of 8 for bitmaps to be sliced by bytes. Constant columns are kept as they are.
+// Returns false if a column can't be sliced (e.g. nested types or unaligned offsets).
+bool sliceArrowArray(ArrowArraySlice& slice,
+                     const ArrowArray* input,
+                     const ArrowSchema* schema,
+                     int64_t begin,
+                     int64_t len);
+
+// Appends all rows of flat input columns to an output column allocated by
+// CiderArrowArrayBufferHolder, value_bytes as in gatherArrowArray. Throws for columns
+// of other formats.
+void concatArrowArrays(ArrowArray* output,
+                       const std::vector<const ArrowArray*>& inputs,
+                       int64_t value_bytes);
+}  // namespace batch_runtime_utils
 }  // namespace cider::exec::nextgen::context
 #endif  // NEXTGEN_CONTEXT_BATCH_H
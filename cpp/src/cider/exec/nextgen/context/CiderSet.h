@@ -22,6 +22,12 @@
 #ifndef CIDER_SET_H
 #define CIDER_SET_H
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
 #include "cider/CiderException.h"
 #include "robin_hood.h"
 
@@ -59,7 +65,9 @@ class CiderSet {
   DEF_CIDER_SET_CONTAINS(std::string)
 };
 
-class CiderInt64Set : public CiderSet {
+// Concrete sets are final and expose non-virtual find() members, runtime functions
+// cast to the concrete type and probe without going through the vtable.
+class CiderInt64Set final : public CiderSet {
  public:
   CiderInt64Set() : CiderSet() {}
 
@@ -71,19 +79,70 @@ class CiderInt64Set : public CiderSet {
 
   void insert(int64_t key_val) override { set_.insert((int64_t)key_val); }
 
-  bool contains(int8_t key_val) override { return set_.contains((int64_t)key_val); }
+  bool contains(int8_t key_val) override { return find(key_val); }
+
+  bool contains(int16_t key_val) override { return find(key_val); }
 
-  bool contains(int16_t key_val) override { return set_.contains((int64_t)key_val); }
+  bool contains(int32_t key_val) override { return find(key_val); }
 
-  bool contains(int32_t key_val) override { return set_.contains((int64_t)key_val); }
+  bool contains(int64_t key_val) override { return find(key_val); }
 
-  bool contains(int64_t key_val) override { return set_.contains(key_val); }
+  bool find(int64_t key_val) const { return set_.contains(key_val); }
 
  private:
   robin_hood::unordered_set<int64_t> set_;
 };
 
-class CiderDoubleSet : public CiderSet {
+// Integer set over a dense [min, max] range, membership is a single bit test.
+class CiderBitmapSet final : public CiderSet {
+ public:
+  CiderBitmapSet(int64_t min, int64_t max) : CiderSet(), min_(min) {
+    // computed in unsigned arithmetic, which can't overflow for min <= max.
+    uint64_t span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    if (max < min || span >= kMaxRange) {
+      CIDER_THROW(CiderCompileException, "Invalid CiderBitmapSet range.");
+    }
+    range_ = span + 1;
+    bitmap_.resize((range_ + 63) / 64, 0);
+  }
+
+  // Ranges of at most kMaxRange values are supported.
+  static constexpr uint64_t kMaxRange = 1ULL << 32;
+
+  void insert(int8_t key_val) override { insert((int64_t)key_val); }
+
+  void insert(int16_t key_val) override { insert((int64_t)key_val); }
+
+  void insert(int32_t key_val) override { insert((int64_t)key_val); }
+
+  void insert(int64_t key_val) override {
+    uint64_t offset = key_val - min_;
+    if (offset >= range_) {
+      CIDER_THROW(CiderRuntimeException, "Value out of CiderBitmapSet range.");
+    }
+    bitmap_[offset >> 6] |= 1ULL << (offset & 63);
+  }
+
+  bool contains(int8_t key_val) override { return find(key_val); }
+
+  bool contains(int16_t key_val) override { return find(key_val); }
+
+  bool contains(int32_t key_val) override { return find(key_val); }
+
+  bool contains(int64_t key_val) override { return find(key_val); }
+
+  bool find(int64_t key_val) const {
+    uint64_t offset = key_val - min_;
+    return offset < range_ && (bitmap_[offset >> 6] >> (offset & 63) & 1);
+  }
+
+ private:
+  int64_t min_;
+  uint64_t range_{0};
+  std::vector<uint64_t> bitmap_;
+};
+
+class CiderDoubleSet final : public CiderSet {
  public:
   CiderDoubleSet() : CiderSet() {}
 
@@ -91,24 +150,105 @@ class CiderDoubleSet : public CiderSet {
 
   void insert(double key_val) override { set_.insert(key_val); }
 
-  bool contains(float key_val) override { return set_.contains((double)key_val); }
+  bool contains(float key_val) override { return find(key_val); }
+
+  bool contains(double key_val) override { return find(key_val); }
 
-  bool contains(double key_val) override { return set_.contains(key_val); }
+  bool find(double key_val) const { return set_.contains(key_val); }
 
  private:
   robin_hood::unordered_set<double> set_;
 };
 
-class CiderStringSet : public CiderSet {
+// String set probed with (ptr, len) views. Values are copied once into a contiguous
+// arena and indexed by an open addressing table of precomputed hashes. A bitmask of
+// the stored lengths rejects most misses before hashing the probe.
+class CiderStringSet final : public CiderSet {
  public:
   CiderStringSet() : CiderSet() {}
 
-  void insert(std::string key_val) override { set_.insert(key_val); }
+  void insert(std::string key_val) override { insert(std::string_view(key_val)); }
 
-  bool contains(std::string key_val) override { return set_.contains(key_val); }
+  bool contains(std::string key_val) override {
+    return find(key_val.data(), key_val.size());
+  }
+
+  void insert(std::string_view key_val) {
+    size_t hash = hashOf(key_val);
+    if (findEntry(key_val, hash) >= 0) {
+      return;
+    }
+    entries_.push_back({hash, arena_.size(), key_val.size()});
+    arena_.append(key_val.data(), key_val.size());
+    length_mask_ |= lengthBit(key_val.size());
+    if (entries_.size() * 2 > slots_.size()) {
+      rehash(std::max<size_t>(16, slots_.size() * 2));
+    } else {
+      placeEntry(entries_.size() - 1);
+    }
+  }
+
+  bool find(const char* str, size_t len) const {
+    if (!(length_mask_ & lengthBit(len))) {
+      return false;
+    }
+    std::string_view key_val(str, len);
+    return findEntry(key_val, hashOf(key_val)) >= 0;
+  }
+
+  size_t size() const { return entries_.size(); }
 
  private:
-  robin_hood::unordered_set<std::string> set_;
+  struct Entry {
+    size_t hash;
+    size_t offset;
+    size_t len;
+  };
+
+  static size_t hashOf(std::string_view key_val) {
+    return std::hash<std::string_view>()(key_val);
+  }
+
+  static uint64_t lengthBit(size_t len) { return 1ULL << (len & 63); }
+
+  int64_t findEntry(std::string_view key_val, size_t hash) const {
+    if (slots_.empty()) {
+      return -1;
+    }
+    size_t mask = slots_.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+      int64_t index = slots_[slot];
+      if (index < 0) {
+        return -1;
+      }
+      const Entry& entry = entries_[index];
+      if (entry.hash == hash && entry.len == key_val.size() &&
+          0 == std::memcmp(arena_.data() + entry.offset, key_val.data(), entry.len)) {
+        return index;
+      }
+    }
+  }
+
+  void placeEntry(size_t index) {
+    size_t mask = slots_.size() - 1;
+    size_t slot = entries_[index].hash & mask;
+    while (slots_[slot] >= 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = index;
+  }
+
+  void rehash(size_t slot_num) {
+    slots_.assign(slot_num, -1);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      placeEntry(i);
+    }
+  }
+
+  std::string arena_;
+  std::vector<Entry> entries_;
+  std::vector<int64_t> slots_;
+  uint64_t length_mask_{0};
 };
 
 using CiderSetPtr = std::unique_ptr<CiderSet>;
@@ -21,6 +21,9 @@
 
 #include "exec/nextgen/context/CodegenContext.h"
 
+#include <re2/re2.h>
+#include <algorithm>
+
 #include "exec/nextgen/context/RuntimeContext.h"
 
 namespace cider::exec::nextgen::context {
@@ -28,7 +31,8 @@ using namespace cider::jitlib;
 
 JITValuePointer CodegenContext::registerBatch(const SQLTypeInfo& type,
                                               const std::string& name,
-                                              bool arrow_array_output) {
+                                              bool arrow_array_output,
+                                              bool string_view) {
   int64_t id = acquireContextID();
   JITValuePointer ret = jit_func_->createLocalJITValue([this, id, arrow_array_output]() {
     auto index = this->jit_func_->createLiteral(JITTypeTag::INT64, id);
@@ -49,7 +53,8 @@ JITValuePointer CodegenContext::registerBatch(const SQLTypeInfo& type,
   });
   ret->setName(name);
 
-  batch_descriptors_.emplace_back(std::make_shared<BatchDescriptor>(id, name, type), ret);
+  batch_descriptors_.emplace_back(
+      std::make_shared<BatchDescriptor>(id, name, type, string_view), ret);
 
   return ret;
 }
@@ -153,6 +158,210 @@ JITValuePointer CodegenContext::registerHashTable(const std::string& name) {
   return ret;
 }
 
+void CodegenContext::codegenInterruptCheck() {
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "check_query_interrupt",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::INT32,
+                                .params_vector = {jit_func_->getArgument(0).get()}});
+  jit_func_->createIfBuilder()
+      ->condition([&ret]() { return ret != 0; })
+      ->ifTrue([this, &ret]() { jit_func_->createReturn(*ret); })
+      ->build();
+}
+
+void CodegenContext::codegenInterruptCheck(JITValuePointer& index) {
+  int64_t interval = codegen_options_.interrupt_check_interval;
+  if (interval <= 0) {
+    return;
+  }
+  jit_func_->createIfBuilder()
+      ->condition([&index, interval]() { return index % interval == interval - 1; })
+      ->ifTrue([this]() { codegenInterruptCheck(); })
+      ->build();
+}
+
+int64_t CodegenContext::registerProfileCounter(ProfileCounterKind kind,
+                                               const std::string& name) {
+  CHECK(codegen_options_.enable_runtime_profile);
+  if (!profile_counters_) {
+    profile_counters_ = std::make_shared<std::vector<ProfileCounterDescriptor>>();
+    profile_counters_ptr_.replace(jit_func_->createLocalJITValue([this]() {
+      return jit_func_->emitRuntimeFunctionCall(
+          "get_query_context_profile_counters",
+          JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                    .ret_sub_type = JITTypeTag::INT64,
+                                    .params_vector = {jit_func_->getArgument(0).get()}});
+    }));
+    profile_counters_ptr_->setName("profile_counters");
+  }
+  profile_counters_->push_back({kind, name});
+  return profile_counters_->size() - 1;
+}
+
+int64_t CodegenContext::getProfileCounterNum(ProfileCounterKind kind) const {
+  if (!profile_counters_) {
+    return 0;
+  }
+  return std::count_if(profile_counters_->begin(),
+                       profile_counters_->end(),
+                       [kind](const auto& counter) { return counter.kind == kind; });
+}
+
+void CodegenContext::codegenProfileCounterAdd(int64_t id, JITValue& value) {
+  CHECK(profile_counters_ && id < profile_counters_->size());
+  auto index = jit_func_->createLiteral(JITTypeTag::INT64, id);
+  auto counter = profile_counters_ptr_[*index];
+  if (value.getValueTypeTag() == JITTypeTag::INT64) {
+    counter = counter + value;
+  } else {
+    counter = counter + *value.castJITValuePrimitiveType(JITTypeTag::INT64);
+  }
+}
+
+void CodegenContext::codegenProfileCounterAdd(int64_t id, int64_t value) {
+  auto literal = jit_func_->createLiteral(JITTypeTag::INT64, value);
+  codegenProfileCounterAdd(id, *literal);
+}
+
+JITValuePointer CodegenContext::registerSelectionVector(JITValuePointer& len) {
+  auto id = jit_func_->createLiteral(JITTypeTag::INT64, selection_vector_num_++);
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "get_query_context_selection_vector",
+      JITFunctionEmitDescriptor{
+          .ret_type = JITTypeTag::POINTER,
+          .ret_sub_type = JITTypeTag::INT32,
+          .params_vector = {jit_func_->getArgument(0).get(), id.get(), len.get()}});
+  ret->setName("selection_vector");
+  return ret;
+}
+
+JITValuePointer CodegenContext::registerValueIndices(JITValuePointer& arrow_array,
+                                                     JITValuePointer& len) {
+  auto id = jit_func_->createLiteral(JITTypeTag::INT64, selection_vector_num_++);
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "get_query_context_value_indices",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                .ret_sub_type = JITTypeTag::INT32,
+                                .params_vector = {jit_func_->getArgument(0).get(),
+                                                  arrow_array.get(),
+                                                  id.get(),
+                                                  len.get()}});
+  ret->setName("value_indices");
+  return ret;
+}
+
+JITValuePointer CodegenContext::registerRowValidity(JITValuePointer& arrow_array,
+                                                    JITValuePointer& len) {
+  auto id = jit_func_->createLiteral(JITTypeTag::INT64, selection_vector_num_++);
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "get_query_context_row_validity",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                .ret_sub_type = JITTypeTag::INT8,
+                                .params_vector = {jit_func_->getArgument(0).get(),
+                                                  arrow_array.get(),
+                                                  id.get(),
+                                                  len.get()}});
+  ret->setName("row_validity");
+  return ret;
+}
+
+JITValuePointer CodegenContext::registerCaseConvertedStrings(
+    JITValuePointer& arrow_array,
+    bool upper) {
+  auto id = jit_func_->createLiteral(JITTypeTag::INT64, selection_vector_num_++);
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "get_query_context_case_converted_strings",
+      JITFunctionEmitDescriptor{
+          .ret_type = JITTypeTag::POINTER,
+          .ret_sub_type = JITTypeTag::INT8,
+          .params_vector = {jit_func_->getArgument(0).get(),
+                            arrow_array.get(),
+                            id.get(),
+                            jit_func_->createLiteral(JITTypeTag::BOOL, upper).get()}});
+  ret->setName(upper ? "upper_strings" : "lower_strings");
+  return ret;
+}
+
+JITValuePointer CodegenContext::registerDictionaryPredicateResults(
+    JITValuePointer& arrow_array,
+    int id) {
+  auto ret = jit_func_->emitRuntimeFunctionCall(
+      "get_query_context_dictionary_predicate_results",
+      JITFunctionEmitDescriptor{
+          .ret_type = JITTypeTag::POINTER,
+          .ret_sub_type = JITTypeTag::INT8,
+          .params_vector = {jit_func_->getArgument(0).get(),
+                            arrow_array.get(),
+                            jit_func_->createLiteral(JITTypeTag::INT32, id).get()}});
+  ret->setName("dictionary_predicate_results");
+  return ret;
+}
+
+JITValuePointer& CodegenContext::codegenResumableLoop(JITValuePointer& row_index,
+                                                      JITValuePointer& row_upper) {
+  CHECK_GT(codegen_options_.max_output_rows, 0);
+  CHECK(!isResumableLoop());
+  resumable_loop_.cursor.replace(jit_func_->createLocalJITValue([this]() {
+    return jit_func_->emitRuntimeFunctionCall(
+        "get_query_context_resume_cursor",
+        JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                  .ret_sub_type = JITTypeTag::INT64,
+                                  .params_vector = {jit_func_->getArgument(0).get()}});
+  }));
+  resumable_loop_.output_full.replace(
+      jit_func_->createVariable(JITTypeTag::BOOL, "output_full", false));
+  resumable_loop_.row_index.replace(row_index);
+  resumable_loop_.row_upper.replace(row_upper);
+
+  auto row_slot = jit_func_->createLiteral(JITTypeTag::INT64, 0l);
+  row_index = *resumable_loop_.cursor[*row_slot];
+  return resumable_loop_.output_full;
+}
+
+JITValuePointer& CodegenContext::codegenResumableMatchLoop(JITValuePointer& match_index,
+                                                           JITValuePointer& match_upper) {
+  CHECK(isResumableLoop());
+  CHECK(resumable_loop_.match_index.get() == nullptr);
+  resumable_loop_.match_index.replace(match_index);
+  resumable_loop_.match_upper.replace(match_upper);
+
+  // Only the resumed row starts from the saved match.
+  auto match_slot_index = jit_func_->createLiteral(JITTypeTag::INT64, 1l);
+  auto match_slot = resumable_loop_.cursor[*match_slot_index];
+  match_index = *match_slot;
+  match_slot = *jit_func_->createLiteral(JITTypeTag::INT64, 0l);
+  return resumable_loop_.output_full;
+}
+
+void CodegenContext::codegenOutputYield(JITValuePointer& output_rows) {
+  CHECK(isResumableLoop());
+  auto& loop = resumable_loop_;
+  jit_func_->createIfBuilder()
+      ->condition([&]() { return output_rows >= codegen_options_.max_output_rows; })
+      ->ifTrue([&]() {
+        // Save the position after current output row, that is the next match of current
+        // row if any, the next row otherwise.
+        auto next_row = loop.row_index + 1l;
+        auto next_match = jit_func_->createLiteral(JITTypeTag::INT64, 0l);
+        if (loop.match_index.get()) {
+          auto has_next_match = (loop.match_index + 1l < loop.match_upper)
+                                    ->castJITValuePrimitiveType(JITTypeTag::INT64);
+          next_row.replace(next_row - has_next_match);
+          next_match.replace((loop.match_index + 1l) * has_next_match);
+        }
+        auto pending =
+            (next_row < loop.row_upper)->castJITValuePrimitiveType(JITTypeTag::INT64);
+
+        JITValuePointer* values[] = {&next_row, &next_match, &pending};
+        for (int64_t i = 0; i < 3; ++i) {
+          auto slot = loop.cursor[*jit_func_->createLiteral(JITTypeTag::INT64, i)];
+          slot = **values[i];
+        }
+        loop.output_full = *jit_func_->createLiteral(JITTypeTag::BOOL, true);
+      })
+      ->build();
+}
+
 RuntimeCtxPtr CodegenContext::generateRuntimeCTX(
     const CiderAllocatorPtr& allocator) const {
   auto runtime_ctx = std::make_unique<RuntimeContext>(getNextContextID());
@@ -171,6 +380,10 @@ RuntimeCtxPtr CodegenContext::generateRuntimeCTX(
   }
 
   runtime_ctx->setTrimStringOperCharMaps(trim_char_maps_);
+  runtime_ctx->setRegexes(regexes_);
+  runtime_ctx->setDictionaryPredicates(dictionary_predicates_);
+  runtime_ctx->setProfileCounters(profile_counters_);
+  runtime_ctx->setSelectionVectorNum(selection_vector_num_);
 
   runtime_ctx->instantiate(allocator);
   return runtime_ctx;
@@ -190,6 +403,28 @@ int CodegenContext::registerTrimStringOperCharMap(const std::string& trim_chars)
   return trim_char_maps_->size() - 1;
 }
 
+int CodegenContext::registerRegex(const std::string& pattern) {
+  if (!regexes_) {
+    regexes_ = std::make_shared<std::vector<std::unique_ptr<re2::RE2>>>();
+  }
+
+  for (size_t i = 0; i < regexes_->size(); ++i) {
+    if (regexes_->at(i)->pattern() == pattern) {
+      return i;
+    }
+  }
+  regexes_->emplace_back(std::make_unique<re2::RE2>(pattern));
+  return regexes_->size() - 1;
+}
+
+int CodegenContext::registerDictionaryPredicate(StringPredicate predicate) {
+  if (!dictionary_predicates_) {
+    dictionary_predicates_ = std::make_shared<std::vector<StringPredicate>>();
+  }
+  dictionary_predicates_->emplace_back(std::move(predicate));
+  return dictionary_predicates_->size() - 1;
+}
+
 std::string AggExprsInfo::getAggName(SQLAgg agg_type, SQLTypes sql_type) {
   std::string agg_name = "nextgen_cider_agg";
   switch (agg_type) {
@@ -246,6 +481,35 @@ jitlib::JITValuePointer getArrowArrayBuffer(jitlib::JITValuePointer& arrow_array
   return ret;
 }
 
+jitlib::JITValuePointer getArrowArrayValuesBuffer(jitlib::JITValuePointer& arrow_array,
+                                                  int64_t index) {
+  CHECK(arrow_array->getValueTypeTag() == JITTypeTag::POINTER);
+  CHECK(arrow_array->getValueSubTypeTag() == JITTypeTag::INT8);
+
+  auto& func = arrow_array->getParentJITFunction();
+  auto jit_index = func.createLiteral(JITTypeTag::INT64, index);
+  auto ret = func.emitRuntimeFunctionCall(
+      "extract_arrow_array_values_buffer",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                .ret_sub_type = JITTypeTag::INT8,
+                                .params_vector = {arrow_array.get(), jit_index.get()}});
+  ret->setName("values_buffer");
+  return ret;
+}
+
+jitlib::JITValuePointer getArrowArrayEncoding(jitlib::JITValuePointer& arrow_array) {
+  CHECK(arrow_array->getValueTypeTag() == JITTypeTag::POINTER);
+  CHECK(arrow_array->getValueSubTypeTag() == JITTypeTag::INT8);
+
+  auto& func = arrow_array->getParentJITFunction();
+  auto ret = func.emitRuntimeFunctionCall(
+      "get_arrow_array_encoding",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::INT32,
+                                .params_vector = {arrow_array.get()}});
+  ret->setName("encoding");
+  return ret;
+}
+
 jitlib::JITValuePointer getArrowArrayChild(jitlib::JITValuePointer& arrow_array,
                                            int64_t index) {
   CHECK(arrow_array->getValueTypeTag() == JITTypeTag::POINTER);
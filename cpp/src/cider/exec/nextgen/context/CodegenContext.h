@@ -21,6 +21,10 @@
 #ifndef NEXTGEN_CONTEXT_CODEGENCONTEXT_H
 #define NEXTGEN_CONTEXT_CODEGENCONTEXT_H
 
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
 #include "common/interpreters/AggregationHashTable.h"
 #include "exec/nextgen/context/Buffer.h"
 #include "exec/nextgen/context/CiderSet.h"
@@ -32,6 +36,10 @@
 #endif
 #include "util/sqldefs.h"
 
+namespace re2 {
+class RE2;
+}
+
 namespace cider::exec::nextgen::context {
 
 class RuntimeContext;
@@ -67,12 +75,46 @@ struct AggExprsInfo {
 
 using AggExprsInfoVector = std::vector<AggExprsInfo>;
 
+enum class ProfileCounterKind {
+  kFilterInput,
+  kFilterOutput,
+  kJoinProbe,
+  kJoinMatch,
+  kInputRows,
+  kColumnNull,
+  kConjunctInput,
+  kConjunctOutput,
+};
+
+struct ProfileCounterDescriptor {
+  ProfileCounterKind kind;
+  // Operator or column the counter belongs to, e.g. "filter_0".
+  std::string name;
+};
+
 struct CodegenOptions {
   bool needs_error_check = false;
   bool check_bit_vector_clear_opt = false;
   bool set_null_bit_vector_opt = false;
   bool branchless_logic = true;
   bool enable_vectorize = false;
+  // Rows processed between two interrupt polls in generated loops, 0 disables polling.
+  int64_t interrupt_check_interval = 65536;
+  // Upper bound of rows in an output batch, 0 means unbounded. A bounded query function
+  // stops once the output batch is full, and the next run over the same input resumes
+  // from the saved input row and join match.
+  int64_t max_output_rows = 0;
+  // Instruments generated code with runtime counters (filter selectivity, join fan-out
+  // and null rates). Stateless processors recompile with the measured profile after
+  // profile_batch_num batches.
+  bool enable_runtime_profile = false;
+  int64_t profile_batch_num = 4;
+  // Writes varchar output columns as Arrow Utf8View ("vu"): 16 bytes views with strings
+  // longer than 12 bytes appended to a single data buffer, instead of offsets and data.
+  bool string_view_output = false;
+  // Measured selectivity of filter conjuncts keyed by their position in the plan (see
+  // CodegenContext::registerFilter), used to order conjuncts.
+  std::shared_ptr<const std::unordered_map<std::string, double>> conjunct_selectivity;
 
   jitlib::CompilationOptions co = jitlib::CompilationOptions{};
 };
@@ -103,7 +145,8 @@ class CodegenContext {
 
   jitlib::JITValuePointer registerBatch(const SQLTypeInfo& type,
                                         const std::string& name = "",
-                                        bool arrow_array_output = true);
+                                        bool arrow_array_output = true,
+                                        bool string_view = false);
 
   // TBD: HashTable (GroupBy, Join), other objects registration.
   jitlib::JITValuePointer registerBuffer(
@@ -126,15 +169,107 @@ class CodegenContext {
                                            const SQLTypeInfo& type,
                                            CiderSetPtr c_set);
 
+  // Emits a poll of query interruption, the query function returns the error code once
+  // interrupted.
+  void codegenInterruptCheck();
+
+  // Emits a poll every interrupt_check_interval iterations of the loop driven by index
+  // (short loops never poll). The poll is a call and an exit inside the loop body, row
+  // loops which may vectorize poll between chunks of rows instead, see
+  // ColumnToRowTranslator.
+  void codegenInterruptCheck(jitlib::JITValuePointer& index);
+
+  // Registers a runtime counter, returns its id. Only valid if enable_runtime_profile.
+  int64_t registerProfileCounter(ProfileCounterKind kind, const std::string& name);
+
+  // Number of registered counters of given kind, used for naming operator counters.
+  int64_t getProfileCounterNum(ProfileCounterKind kind) const;
+
+  // Returns the name of a filter, "filter_<n>" for the n-th filter translated. Names
+  // are the same in every compilation of a plan whether profiled or not, so counters
+  // of a filter are found again on recompilation.
+  std::string registerFilter() { return "filter_" + std::to_string(filter_num_++); }
+
+  // Emits counter += value (INT64 or BOOL).
+  void codegenProfileCounterAdd(int64_t id, jitlib::JITValue& value);
+
+  void codegenProfileCounterAdd(int64_t id, int64_t value);
+
+  // Emits the fetch of a runtime INT32 buffer able to hold len row indices, the buffer
+  // is reused across batches.
+  jitlib::JITValuePointer registerSelectionVector(jitlib::JITValuePointer& len);
+
+  // Emits the fetch of INT32 value indices of rows [0, len) of an encoded input column
+  // (see RuntimeContext::getValueIndices), run-end encoded columns are decoded into a
+  // runtime buffer reused across batches.
+  jitlib::JITValuePointer registerValueIndices(jitlib::JITValuePointer& arrow_array,
+                                               jitlib::JITValuePointer& len);
+
+  // Emits the fetch of validity bits of rows [0, len) of an input column (see
+  // RuntimeContext::getRowValidity).
+  jitlib::JITValuePointer registerRowValidity(jitlib::JITValuePointer& arrow_array,
+                                              jitlib::JITValuePointer& len);
+
+  // Emits the ASCII case conversion of the data buffer of a varchar input column (see
+  // RuntimeContext::getCaseConvertedStrings), converted values keep the offsets of the
+  // input values.
+  jitlib::JITValuePointer registerCaseConvertedStrings(
+      jitlib::JITValuePointer& arrow_array,
+      bool upper);
+
+  // Emits the fetch of the results of dictionary predicate id over the dictionary of a
+  // varchar input column (see RuntimeContext::getDictionaryPredicateResults), null if
+  // the column is not dictionary-encoded.
+  jitlib::JITValuePointer registerDictionaryPredicateResults(
+      jitlib::JITValuePointer& arrow_array,
+      int id);
+
+  // Publishes rows selected by a vectorized filter, the next ColumnToRow loop iterates
+  // over selection[0, count) instead of all input rows.
+  void setFilterSelection(jitlib::JITValuePointer& selection,
+                          jitlib::JITValuePointer& count) {
+    CHECK(filter_selection_.first.get() == nullptr);
+    filter_selection_.first.replace(selection);
+    filter_selection_.second.replace(count);
+  }
+
+  bool hasFilterSelection() const { return filter_selection_.first.get() != nullptr; }
+
+  std::pair<jitlib::JITValuePointer, jitlib::JITValuePointer> takeFilterSelection() {
+    return std::move(filter_selection_);
+  }
+
+  // Emits the start of a bounded row loop (see max_output_rows) over row_index, which
+  // restarts from the row saved by the last yield. Returns the BOOL variable set once
+  // the output batch is full, loop conditions should test it.
+  jitlib::JITValuePointer& codegenResumableLoop(jitlib::JITValuePointer& row_index,
+                                                jitlib::JITValuePointer& row_upper);
+
+  bool isResumableLoop() const { return resumable_loop_.cursor.get() != nullptr; }
+
+  // Same as codegenResumableLoop for the loop over join matches of the current row.
+  jitlib::JITValuePointer& codegenResumableMatchLoop(
+      jitlib::JITValuePointer& match_index,
+      jitlib::JITValuePointer& match_upper);
+
+  // Emits the yield of a bounded loop, once output_rows reaches max_output_rows the
+  // position after the current output row is saved and the loops end.
+  void codegenOutputYield(jitlib::JITValuePointer& output_rows);
+
   RuntimeCtxPtr generateRuntimeCTX(const CiderAllocatorPtr& allocator) const;
 
   struct BatchDescriptor {
     int64_t ctx_id;
     std::string name;
     SQLTypeInfo type;
-
-    BatchDescriptor(int64_t id, const std::string& n, const SQLTypeInfo& t)
-        : ctx_id(id), name(n), type(t) {}
+    // Whether varchar columns use Utf8View layout.
+    bool string_view;
+
+    BatchDescriptor(int64_t id,
+                    const std::string& n,
+                    const SQLTypeInfo& t,
+                    bool sv = false)
+        : ctx_id(id), name(n), type(t), string_view(sv) {}
   };
 
   struct BufferDescriptor {
@@ -197,6 +332,8 @@ class CodegenContext {
 
   void setJITModule(jitlib::JITModulePointer jit_module) { jit_module_ = jit_module; }
 
+  const jitlib::JITModulePointer& getJITModule() const { return jit_module_; }
+
   void setCodegenOptions(CodegenOptions codegen_options) {
     codegen_options_ = codegen_options;
   }
@@ -206,11 +343,25 @@ class CodegenContext {
   using HashTableDescriptorPtr = std::shared_ptr<HashTableDescriptor>;
   using CiderSetDescriptorPtr = std::shared_ptr<CiderSetDescriptor>;
   using TrimCharMapsPtr = std::shared_ptr<std::vector<std::vector<int8_t>>>;
+  using RegexesPtr = std::shared_ptr<std::vector<std::unique_ptr<re2::RE2>>>;
+  using StringPredicate = std::function<bool(std::string_view)>;
+  using StringPredicatesPtr = std::shared_ptr<std::vector<StringPredicate>>;
+  using ProfileCounterDescriptorsPtr =
+      std::shared_ptr<std::vector<ProfileCounterDescriptor>>;
 
   // registers a set of trim characters for TrimStringOper, to be used at runtime
   // returns an index used for retrieving the charset at runtime
   int registerTrimStringOperCharMap(const std::string& trim_chars);
 
+  // compiles a constant pattern of REGEXP_* functions once, to be shared by runtime
+  // contexts. returns an index used for retrieving the compiled regex at runtime
+  int registerRegex(const std::string& pattern);
+
+  // registers a predicate of a string expression whose other operands are constant, to
+  // be evaluated once per dictionary entry of dictionary-encoded input. returns an index
+  // used for retrieving the results at runtime
+  int registerDictionaryPredicate(StringPredicate predicate);
+
  private:
   int64_t acquireContextID() { return id_counter_++; }
   int64_t getNextContextID() const { return id_counter_; }
@@ -237,6 +388,25 @@ class CodegenContext {
 
   // use shared_ptr here to avoid copying the entire 2d vector when creating runtime ctx
   TrimCharMapsPtr trim_char_maps_;
+  RegexesPtr regexes_;
+  StringPredicatesPtr dictionary_predicates_;
+
+  ProfileCounterDescriptorsPtr profile_counters_;
+  jitlib::JITValuePointer profile_counters_ptr_;
+
+  int64_t filter_num_{0};
+  int64_t selection_vector_num_{0};
+  std::pair<jitlib::JITValuePointer, jitlib::JITValuePointer> filter_selection_;
+
+  struct ResumableLoop {
+    // INT64* of RuntimeContext::getResumeCursor().
+    jitlib::JITValuePointer cursor;
+    jitlib::JITValuePointer output_full;
+    jitlib::JITValuePointer row_index;
+    jitlib::JITValuePointer row_upper;
+    jitlib::JITValuePointer match_index;
+    jitlib::JITValuePointer match_upper;
+  } resumable_loop_;
 };
 
 using CodegenCtxPtr = std::unique_ptr<CodegenContext>;
@@ -250,6 +420,14 @@ void setArrowArrayLength(jitlib::JITValuePointer& arrow_array,
 jitlib::JITValuePointer getArrowArrayBuffer(jitlib::JITValuePointer& arrow_array,
                                             int64_t index);
 
+// Same as getArrowArrayBuffer, but buffers of dictionary-encoded arrays are taken from
+// the dictionary.
+jitlib::JITValuePointer getArrowArrayValuesBuffer(jitlib::JITValuePointer& arrow_array,
+                                                  int64_t index);
+
+// Returns batch_runtime_utils::ArrowArrayEncoding of arrow_array as INT32.
+jitlib::JITValuePointer getArrowArrayEncoding(jitlib::JITValuePointer& arrow_array);
+
 jitlib::JITValuePointer getArrowArrayChild(jitlib::JITValuePointer& arrow_array,
                                            int64_t index);
 
@@ -44,6 +44,68 @@ extern "C" ALWAYS_INLINE int8_t* get_query_context_trim_char_map_by_id(int8_t* c
   return const_cast<int8_t*>(context_ptr->getTrimStringOperCharMapById(id));
 }
 
+extern "C" ALWAYS_INLINE int8_t* get_query_context_regex(int8_t* context,
+                                                        int id,
+                                                        const char* pattern_ptr,
+                                                        int pattern_len) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return reinterpret_cast<int8_t*>(
+      const_cast<re2::RE2*>(context_ptr->getRegex(id, pattern_ptr, pattern_len)));
+}
+
+extern "C" ALWAYS_INLINE int32_t check_query_interrupt(int8_t* context) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->checkInterrupt();
+}
+
+extern "C" ALWAYS_INLINE int64_t* get_query_context_profile_counters(int8_t* context) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getProfileCounters();
+}
+
+extern "C" ALWAYS_INLINE int32_t* get_query_context_selection_vector(int8_t* context,
+                                                                     int64_t id,
+                                                                     int64_t len) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getSelectionVector(id, len);
+}
+
+extern "C" ALWAYS_INLINE int64_t* get_query_context_resume_cursor(int8_t* context) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getResumeCursor();
+}
+
+extern "C" ALWAYS_INLINE void pass_through_arrow_array(int8_t* context,
+                                                      int8_t* output,
+                                                      int8_t* input,
+                                                      int64_t value_bytes,
+                                                      int64_t len) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  context_ptr->passThroughArrowArray(reinterpret_cast<ArrowArray*>(output),
+                                     reinterpret_cast<ArrowArray*>(input),
+                                     value_bytes,
+                                     len);
+}
+
+extern "C" ALWAYS_INLINE void gather_arrow_array(int8_t* output,
+                                                int8_t* input,
+                                                int64_t value_bytes,
+                                                int32_t* selection,
+                                                int64_t count) {
+  cider::exec::nextgen::context::batch_runtime_utils::gatherArrowArray(
+      reinterpret_cast<ArrowArray*>(output),
+      reinterpret_cast<ArrowArray*>(input),
+      value_bytes,
+      selection,
+      count);
+}
+
 extern "C" ALWAYS_INLINE int8_t* get_arrow_array_ptr(int8_t* batch) {
   auto batch_ptr = reinterpret_cast<cider::exec::nextgen::context::Batch*>(batch);
   return reinterpret_cast<int8_t*>(batch_ptr->getArray());
@@ -61,6 +123,62 @@ extern "C" ALWAYS_INLINE void* extract_arrow_array_child(int8_t* arrow_pointer,
   return reinterpret_cast<void*>(array->children[index]);
 }
 
+// Buffers of encoded arrays are held by their values.
+extern "C" ALWAYS_INLINE void* extract_arrow_array_values_buffer(int8_t* arrow_pointer,
+                                                                 int64_t index) {
+  ArrowArray* array = reinterpret_cast<ArrowArray*>(arrow_pointer);
+  auto values =
+      cider::exec::nextgen::context::batch_runtime_utils::getArrowArrayValues(array);
+  return const_cast<void*>(values->buffers[index]);
+}
+
+extern "C" ALWAYS_INLINE int32_t get_arrow_array_encoding(int8_t* arrow_pointer) {
+  ArrowArray* array = reinterpret_cast<ArrowArray*>(arrow_pointer);
+  return static_cast<int32_t>(
+      cider::exec::nextgen::context::batch_runtime_utils::getArrowArrayEncoding(array));
+}
+
+extern "C" ALWAYS_INLINE int32_t* get_query_context_value_indices(int8_t* context,
+                                                                  int8_t* arrow_pointer,
+                                                                  int64_t id,
+                                                                  int64_t len) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getValueIndices(
+      reinterpret_cast<ArrowArray*>(arrow_pointer), id, len);
+}
+
+extern "C" ALWAYS_INLINE uint8_t* get_query_context_row_validity(int8_t* context,
+                                                                 int8_t* arrow_pointer,
+                                                                 int64_t id,
+                                                                 int64_t len) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getRowValidity(
+      reinterpret_cast<ArrowArray*>(arrow_pointer), id, len);
+}
+
+extern "C" ALWAYS_INLINE int8_t* get_query_context_case_converted_strings(
+    int8_t* context,
+    int8_t* arrow_pointer,
+    int64_t id,
+    bool upper) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getCaseConvertedStrings(
+      reinterpret_cast<ArrowArray*>(arrow_pointer), id, upper);
+}
+
+extern "C" ALWAYS_INLINE int8_t* get_query_context_dictionary_predicate_results(
+    int8_t* context,
+    int8_t* arrow_pointer,
+    int id) {
+  auto context_ptr =
+      reinterpret_cast<cider::exec::nextgen::context::RuntimeContext*>(context);
+  return context_ptr->getDictionaryPredicateResults(
+      reinterpret_cast<ArrowArray*>(arrow_pointer), id);
+}
+
 extern "C" ALWAYS_INLINE int64_t extract_arrow_array_len(int8_t* arrow_pointer) {
   ArrowArray* array = reinterpret_cast<ArrowArray*>(arrow_pointer);
   return array->length;
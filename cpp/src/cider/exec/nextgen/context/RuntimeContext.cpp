@@ -20,10 +20,17 @@
  */
 
 #include "exec/nextgen/context/RuntimeContext.h"
+
+#include <re2/re2.h>
+#include <algorithm>
+#include <sstream>
+
 #include "exec/module/batch/CiderArrowBufferHolder.h"
 #include "exec/nextgen/operators/extractor/AggExtractorBuilder.h"
 
 namespace cider::exec::nextgen::context {
+RuntimeContext::~RuntimeContext() = default;
+
 void RuntimeContext::addBatch(const CodegenContext::BatchDescriptorPtr& descriptor) {
   batch_holder_.emplace_back(descriptor, nullptr);
 }
@@ -46,7 +53,8 @@ void RuntimeContext::instantiate(const CiderAllocatorPtr& allocator) {
   // Instantiation of batches.
   for (auto& batch_desc : batch_holder_) {
     if (nullptr == batch_desc.second) {
-      batch_desc.second = std::make_unique<Batch>(batch_desc.first->type, allocator);
+      batch_desc.second = std::make_unique<Batch>(
+          batch_desc.first->type, allocator, batch_desc.first->string_view);
       runtime_ctx_pointers_[batch_desc.first->ctx_id] = batch_desc.second.get();
     }
   }
@@ -130,4 +138,224 @@ const int8_t* RuntimeContext::getTrimStringOperCharMapById(int id) const {
   return trim_char_maps_->at(id).data();
 }
 
+void RuntimeContext::setRegexes(const CodegenContext::RegexesPtr& regexes) {
+  regexes_ = regexes;
+}
+
+const re2::RE2* RuntimeContext::getRegex(int id,
+                                         const char* pattern_ptr,
+                                         int pattern_len) {
+  if (id >= 0) {
+    return regexes_->at(id).get();
+  }
+  std::string_view pattern(pattern_ptr, pattern_len);
+  for (auto it = regex_cache_.begin(); it != regex_cache_.end(); ++it) {
+    if ((*it)->pattern() == pattern) {
+      regex_cache_.splice(regex_cache_.begin(), regex_cache_, it);
+      return regex_cache_.front().get();
+    }
+  }
+  if (regex_cache_.size() == kRegexCacheCapacity) {
+    regex_cache_.pop_back();
+  }
+  regex_cache_.emplace_front(
+      std::make_unique<re2::RE2>(re2::StringPiece(pattern_ptr, pattern_len)));
+  return regex_cache_.front().get();
+}
+
+void RuntimeContext::setDictionaryPredicates(
+    const CodegenContext::StringPredicatesPtr& predicates) {
+  dictionary_predicates_ = predicates;
+  dictionary_predicate_results_.clear();
+  dictionary_predicate_results_.resize(predicates ? predicates->size() : 0);
+}
+
+int8_t* RuntimeContext::getDictionaryPredicateResults(const ArrowArray* array, int id) {
+  if (batch_runtime_utils::getArrowArrayEncoding(array) !=
+      batch_runtime_utils::ArrowArrayEncoding::kDictionary) {
+    return nullptr;
+  }
+  auto values = batch_runtime_utils::getArrowArrayValues(array);
+  auto offsets = reinterpret_cast<const int32_t*>(values->buffers[1]) + values->offset;
+  auto data = reinterpret_cast<const char*>(values->buffers[2]);
+  std::string_view used_data(data + offsets[0], offsets[values->length] - offsets[0]);
+  // Results only depend on the offsets and the data they point to, a dictionary equal
+  // to the cached one may be in other buffers (e.g. copied into every batch).
+  auto& cache = dictionary_predicate_results_[id];
+  if (cache.offsets.size() == static_cast<size_t>(values->length + 1) &&
+      std::equal(cache.offsets.begin(), cache.offsets.end(), offsets) &&
+      cache.data == used_data) {
+    return cache.results.data();
+  }
+
+  auto& predicate = dictionary_predicates_->at(id);
+  cache.results.assign(offsets[values->length] + 1, 0);
+  cache.results[0] = predicate(std::string_view());
+  for (int64_t i = 0; i < values->length; ++i) {
+    if (offsets[i + 1] > offsets[i]) {
+      cache.results[offsets[i] + 1] =
+          predicate(std::string_view(data + offsets[i], offsets[i + 1] - offsets[i]));
+    }
+  }
+  cache.offsets.assign(offsets, offsets + values->length + 1);
+  cache.data.assign(used_data);
+  return cache.results.data();
+}
+
+void RuntimeContext::setProfileCounters(
+    const CodegenContext::ProfileCounterDescriptorsPtr& counters) {
+  profile_counters_ = counters;
+  profile_counter_values_.assign(counters ? counters->size() : 0, 0);
+}
+
+void RuntimeContext::passThroughArrowArray(ArrowArray* output,
+                                           const ArrowArray* input,
+                                           int64_t value_bytes,
+                                           int64_t len) {
+  // Offset of shared buffers is not respected by output consumers, and encoded input is
+  // decoded.
+  if (!input_array_ || input->offset != 0 ||
+      batch_runtime_utils::getArrowArrayEncoding(input) !=
+          batch_runtime_utils::ArrowArrayEncoding::kFlat) {
+    batch_runtime_utils::gatherArrowArray(output, input, value_bytes, nullptr, len);
+    return;
+  }
+
+  auto holder = reinterpret_cast<CiderArrowArrayBufferHolder*>(output->private_data);
+  for (int64_t i = 0; i < input->n_buffers; ++i) {
+    holder->shareBuffer(i, input->buffers[i], input_array_);
+  }
+  output->length = input->length;
+  output->null_count = input->null_count;
+}
+
+int32_t* RuntimeContext::getSelectionVector(size_t id, int64_t len) {
+  auto& selection = selection_vectors_[id];
+  if (selection.size() < static_cast<size_t>(len)) {
+    selection.resize(len);
+  }
+  return selection.data();
+}
+
+int32_t* RuntimeContext::getValueIndices(const ArrowArray* array,
+                                         size_t id,
+                                         int64_t len) {
+  switch (batch_runtime_utils::getArrowArrayEncoding(array)) {
+    case batch_runtime_utils::ArrowArrayEncoding::kDictionary:
+      return reinterpret_cast<int32_t*>(const_cast<void*>(array->buffers[1]));
+    case batch_runtime_utils::ArrowArrayEncoding::kRunEnd: {
+      auto value_indices = getSelectionVector(id, len);
+      batch_runtime_utils::decodeRunEnds(array, value_indices, len);
+      return value_indices;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+uint8_t* RuntimeContext::getRowValidity(const ArrowArray* array,
+                                        size_t id,
+                                        int64_t len) {
+  switch (batch_runtime_utils::getArrowArrayEncoding(array)) {
+    case batch_runtime_utils::ArrowArrayEncoding::kRunEnd:
+    case batch_runtime_utils::ArrowArrayEncoding::kConstant: {
+      if (!batch_runtime_utils::getArrowArrayValues(array)->buffers[0]) {
+        return nullptr;
+      }
+      auto validity = reinterpret_cast<uint8_t*>(getSelectionVector(id, (len + 31) / 32));
+      batch_runtime_utils::decodeValidity(array, validity, len);
+      return validity;
+    }
+    default:
+      return reinterpret_cast<uint8_t*>(const_cast<void*>(array->buffers[0]));
+  }
+}
+
+int8_t* RuntimeContext::getCaseConvertedStrings(const ArrowArray* array,
+                                                size_t id,
+                                                bool upper) {
+  auto values = batch_runtime_utils::getArrowArrayValues(array);
+  auto offsets = reinterpret_cast<const int32_t*>(values->buffers[1]);
+  auto data = reinterpret_cast<const char*>(values->buffers[2]);
+  int32_t begin = offsets[values->offset];
+  int32_t end = offsets[values->offset + values->length];
+  auto converted = reinterpret_cast<char*>(getSelectionVector(id, (end + 3) / 4));
+  auto& kernels = CiderCpuDispatch::getKernels();
+  (upper ? kernels.ascii_upper : kernels.ascii_lower)(
+      converted + begin, data + begin, end - begin);
+  return reinterpret_cast<int8_t*>(converted);
+}
+
+RuntimeProfile RuntimeContext::getRuntimeProfile() const {
+  RuntimeProfile profile;
+  if (!profile_counters_) {
+    return profile;
+  }
+  auto ratio = [](int64_t numerator, int64_t denominator) {
+    return denominator ? static_cast<double>(numerator) / denominator : 0.0;
+  };
+  // Counters of the same operator are registered adjacently, denominator goes first.
+  int64_t input_rows = 0;
+  for (size_t i = 0; i < profile_counters_->size(); ++i) {
+    auto& [kind, name] = (*profile_counters_)[i];
+    auto value = profile_counter_values_[i];
+    switch (kind) {
+      case ProfileCounterKind::kFilterOutput:
+        profile.filter_selectivity.emplace_back(
+            name, ratio(value, profile_counter_values_[i - 1]));
+        break;
+      case ProfileCounterKind::kConjunctOutput:
+        // Conjuncts behind an always false one are never evaluated.
+        if (profile_counter_values_[i - 1]) {
+          profile.conjunct_selectivity.emplace_back(
+              name, ratio(value, profile_counter_values_[i - 1]));
+        }
+        break;
+      case ProfileCounterKind::kJoinMatch:
+        profile.join_fanout.emplace_back(name,
+                                         ratio(value, profile_counter_values_[i - 1]));
+        break;
+      case ProfileCounterKind::kInputRows:
+        input_rows = value;
+        break;
+      case ProfileCounterKind::kColumnNull:
+        profile.null_rate.emplace_back(name, ratio(value, input_rows));
+        break;
+      default:
+        break;
+    }
+  }
+  return profile;
+}
+
+std::string RuntimeProfile::toString() const {
+  std::ostringstream oss;
+  auto print = [&oss](const char* title, const auto& items) {
+    oss << title << ":";
+    for (auto& [name, value] : items) {
+      oss << " " << name << "=" << value;
+    }
+    oss << "\n";
+  };
+  print("filter selectivity", filter_selectivity);
+  print("conjunct selectivity", conjunct_selectivity);
+  print("join fanout", join_fanout);
+  print("null rate", null_rate);
+  return oss.str();
+}
+
+int32_t RuntimeContext::checkInterrupt() {
+  if (isInterrupted()) {
+    return jitlib::ERROR_CODE::ERR_INTERRUPTED;
+  }
+  if (interrupt_checker_ && interrupt_checker_()) {
+    interrupt();
+    return jitlib::ERROR_CODE::ERR_INTERRUPTED;
+  }
+  if (deadline_ != Clock::time_point::max() && Clock::now() > deadline_) {
+    return jitlib::ERROR_CODE::ERR_OUT_OF_TIME;
+  }
+  return 0;
+}
+
 }  // namespace cider::exec::nextgen::context
@@ -20,6 +20,13 @@
  */
 #ifndef NEXTGEN_CONTEXT_RUNTIMECONTEXT_H
 #define NEXTGEN_CONTEXT_RUNTIMECONTEXT_H
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <string>
+
 #include "exec/nextgen/context/Batch.h"
 #include "exec/nextgen/context/Buffer.h"
 #include "exec/nextgen/context/CiderSet.h"
@@ -27,12 +34,31 @@
 #include "exec/nextgen/context/StringHeap.h"
 #include "exec/nextgen/utils/FunctorUtils.h"
 #include "util/CiderBitUtils.h"
+#include "util/CiderCpuDispatch.h"
 
 namespace cider::exec::nextgen::context {
+
+// Summary of runtime counters, ratios are accumulated over all processed batches.
+struct RuntimeProfile {
+  // Fraction of input rows passing each filter.
+  std::vector<std::pair<std::string, double>> filter_selectivity;
+  // Fraction of evaluated rows passing each filter conjunct, conditioned on the
+  // conjuncts evaluated before it.
+  std::vector<std::pair<std::string, double>> conjunct_selectivity;
+  // Average matched build rows per probe row of each hash join.
+  std::vector<std::pair<std::string, double>> join_fanout;
+  // Fraction of null values of each nullable input column.
+  std::vector<std::pair<std::string, double>> null_rate;
+
+  std::string toString() const;
+};
+
 class RuntimeContext {
  public:
   explicit RuntimeContext(int64_t ctx_num) : runtime_ctx_pointers_(ctx_num, nullptr) {}
 
+  ~RuntimeContext();
+
   size_t getContextItemNum() const { return runtime_ctx_pointers_.size(); }
 
   void* getContextItem(size_t id) { return runtime_ctx_pointers_[id]; }
@@ -52,6 +78,98 @@ class RuntimeContext {
 
   void setTrimStringOperCharMaps(const CodegenContext::TrimCharMapsPtr& maps);
 
+  // Returns the regex compiled at codegen time for id, or for a negative id (a pattern
+  // which is not constant) the cached compiled pattern.
+  const re2::RE2* getRegex(int id, const char* pattern_ptr, int pattern_len);
+
+  void setRegexes(const CodegenContext::RegexesPtr& regexes);
+
+  void setDictionaryPredicates(const CodegenContext::StringPredicatesPtr& predicates);
+
+  // Returns the results of dictionary predicate id over the dictionary of a
+  // dictionary-encoded varchar input column, null for other encodings. A value is looked
+  // up at 1 + its offset in the dictionary data buffer, or at 0 if it's empty. Results
+  // are reused by later batches whose dictionary has the same offsets and data, which
+  // is checked against a copy of the dictionary so that no input batch is kept alive.
+  int8_t* getDictionaryPredicateResults(const ArrowArray* array, int id);
+
+  using InterruptChecker = std::function<bool()>;
+  using InterruptFlag = std::shared_ptr<std::atomic<bool>>;
+  using Clock = std::chrono::steady_clock;
+
+  // Requests the running query to stop, it's safe to be called from any thread.
+  void interrupt() { interrupted_->store(true, std::memory_order_relaxed); }
+
+  bool isInterrupted() const { return interrupted_->load(std::memory_order_relaxed); }
+
+  // Shares the interrupt flag with its owner (e.g. a batch processor), so that the
+  // owner can interrupt the context without accessing it.
+  void setInterruptFlag(const InterruptFlag& flag) { interrupted_ = flag; }
+
+  // External interrupt source (e.g. task abort of host engine), polled together with
+  // the interrupt flag.
+  void setInterruptChecker(const InterruptChecker& checker) {
+    interrupt_checker_ = checker;
+  }
+
+  void setDeadline(Clock::time_point deadline) { deadline_ = deadline; }
+
+  void clearDeadline() { deadline_ = Clock::time_point::max(); }
+
+  // Polled by generated loops, returns ERR_INTERRUPTED, ERR_OUT_OF_TIME or 0.
+  int32_t checkInterrupt();
+
+  void setProfileCounters(const CodegenContext::ProfileCounterDescriptorsPtr& counters);
+
+  int64_t* getProfileCounters() { return profile_counter_values_.data(); }
+
+  RuntimeProfile getRuntimeProfile() const;
+
+  // Input batch of the running query function, passthrough output columns share its
+  // buffers and keep it alive.
+  void setInputArray(std::shared_ptr<const ArrowArray> input) {
+    input_array_ = std::move(input);
+  }
+
+  // Exports an unmodified input column of len rows as output column. Buffers of flat
+  // input are shared if the input batch is held by the context, copied otherwise.
+  void passThroughArrowArray(ArrowArray* output,
+                             const ArrowArray* input,
+                             int64_t value_bytes,
+                             int64_t len);
+
+  void setSelectionVectorNum(size_t num) { selection_vectors_.resize(num); }
+
+  // Returns selection vector id with room for len row indices.
+  int32_t* getSelectionVector(size_t id, int64_t len);
+
+  // Returns value indices of rows [0, len) of a dictionary-encoded or run-end encoded
+  // input column, run indices are decoded into selection vector id. Returns null for
+  // other encodings.
+  int32_t* getValueIndices(const ArrowArray* array, size_t id, int64_t len);
+
+  // Returns validity bits of rows [0, len) of an input column, validity of run-end
+  // encoded and constant columns is decoded into selection vector id.
+  uint8_t* getRowValidity(const ArrowArray* array, size_t id, int64_t len);
+
+  // Returns the ASCII lower or upper cased data buffer of the values of a varchar input
+  // column, converted into selection vector id in one pass. Converted values keep the
+  // offsets of the input values.
+  int8_t* getCaseConvertedStrings(const ArrowArray* array, size_t id, bool upper);
+
+  // Position of a bounded row loop (see CodegenOptions::max_output_rows), as
+  // {input row, join match, output pending}. Generated code saves it when the output
+  // batch is full and resumes from it on the next run over the same input.
+  int64_t* getResumeCursor() { return resume_cursor_.data(); }
+
+  bool hasPendingOutput() const { return resume_cursor_[2] != 0; }
+
+  // Continues from the saved position on the next run.
+  void resumeOutput() { resume_cursor_[2] = 0; }
+
+  // Starts from the first input row on the next run.
+  void resetResumeCursor() { resume_cursor_.fill(0); }
+
   Batch* getOutputBatch() {
     if (batch_holder_.empty()) {
       return nullptr;
@@ -63,15 +181,16 @@ class RuntimeContext {
     auto length = arrow_array->length;
     auto arrow_schema = batch->getSchema();
 
-    auto set_null_count_function =
-        utils::RecursiveFunctor{[&length](auto&& set_null_count_function,
-                                          ArrowArray* arrow_array,
-                                          ArrowSchema* arrow_schema) -> void {
+    auto count_set_bits = CiderCpuDispatch::getKernels().count_set_bits;
+    auto set_null_count_function = utils::RecursiveFunctor{
+        [&length, count_set_bits](auto&& set_null_count_function,
+                                  ArrowArray* arrow_array,
+                                  ArrowSchema* arrow_schema) -> void {
           if (arrow_array->buffers[0]) {
             arrow_array->null_count =
-                length -
-                CiderBitUtils::countSetBits(
-                    reinterpret_cast<const uint8_t*>(arrow_array->buffers[0]), length);
+                length - count_set_bits(
+                             reinterpret_cast<const uint8_t*>(arrow_array->buffers[0]),
+                             length);
           }
           for (size_t i = 0; i < arrow_schema->n_children; ++i) {
             set_null_count_function(arrow_array->children[i], arrow_schema->children[i]);
@@ -87,7 +206,7 @@ class RuntimeContext {
   void resetBatch(const CiderAllocatorPtr& allocator) {
     if (!batch_holder_.empty()) {
       auto& [descriptor, batch] = batch_holder_.front();
-      batch->reset(descriptor->type, allocator);
+      batch->reset(descriptor->type, allocator, descriptor->string_view);
     }
   }
 
@@ -100,6 +219,33 @@ class RuntimeContext {
   std::shared_ptr<StringHeap> string_heap_ptr_;
   CodegenContext::HashTableDescriptorPtr hashtable_holder_;
   CodegenContext::TrimCharMapsPtr trim_char_maps_;
+  CodegenContext::RegexesPtr regexes_;
+  // Compiled patterns which are not constant, the least recently used one is evicted
+  // once the cache is full.
+  static constexpr size_t kRegexCacheCapacity = 16;
+  std::list<std::unique_ptr<re2::RE2>> regex_cache_;
+  CodegenContext::StringPredicatesPtr dictionary_predicates_;
+
+  struct DictionaryPredicateResults {
+    // Copy of the offsets and the used data of the dictionary the results are for.
+    std::vector<int32_t> offsets;
+    std::string data;
+    std::vector<int8_t> results;
+  };
+  std::vector<DictionaryPredicateResults> dictionary_predicate_results_;
+
+  InterruptFlag interrupted_{std::make_shared<std::atomic<bool>>(false)};
+  InterruptChecker interrupt_checker_;
+  Clock::time_point deadline_{Clock::time_point::max()};
+
+  CodegenContext::ProfileCounterDescriptorsPtr profile_counters_;
+  std::vector<int64_t> profile_counter_values_;
+
+  std::vector<std::vector<int32_t>> selection_vectors_;
+
+  std::shared_ptr<const ArrowArray> input_array_;
+
+  std::array<int64_t, 3> resume_cursor_{0, 0, 0};
 };
 
 using RuntimeCtxPtr = std::unique_ptr<RuntimeContext>;
@@ -22,27 +22,9 @@
 #ifndef NEXTGEN_CONTEXT_STRING_HEAP_H
 #define NEXTGEN_CONTEXT_STRING_HEAP_H
 
-#include "cider/CiderAllocator.h"
-
-struct string_t {
-  string_t(const char* data, uint32_t len) {
-    value.pointer.length = len;
-    value.pointer.ptr = (char*)data;
-  }
-  char* getDataWriteable() const { return value.pointer.ptr; }
-  const char* getDataUnsafe() const { return value.pointer.ptr; }
-  size_t getSize() const { return value.pointer.length; }
+#include <cstring>
 
- private:
-  // TODO: may use velox/duckdb short string represetation in the future.
-  union {
-    struct {
-      uint32_t length;
-      char prefix[4];
-      char* ptr;
-    } pointer;
-  } value;
-};
+#include "cider/CiderAllocator.h"
 
 class StringHeap {
  public:
@@ -57,30 +39,23 @@ class StringHeap {
     total_num_ = 0;
   }
 
-  // Add a string to the string heap, returns a pointer to the string
-  string_t addString(const char* data, size_t len) { return addBlob(data, len); }
-  // Add a string to the string heap, returns a pointer to the string
-  string_t addString(const string_t& data) {
-    return addString(data.getDataUnsafe(), data.getSize());
-  }
-  // Allocates space for an empty string of size "len" on the heap
-  string_t emptyString(size_t len) {
+  // Allocates len bytes for a string written by the caller. Generated code reads
+  // strings through a (pointer, length) pair, so runtime functions keep their results
+  // in the heap whatever the length is.
+  char* allocateStringData(size_t len) {
     total_num_++;
-    auto pointer = (const char*)allocator_.allocate(len);
-    return string_t(pointer, len);
+    return (char*)allocator_.allocate(len);
+  }
+  // Copies a string to the heap, returns its data.
+  const char* addStringData(const char* data, size_t len) {
+    auto pointer = allocateStringData(len);
+    std::memcpy(pointer, data, len);
+    return pointer;
   }
   // Returns how many string stored in this heap
   size_t getNum() { return total_num_; }
 
  private:
-  //! Add a blob to the string heap;
-  string_t addBlob(const char* data, size_t len) {
-    auto insert_string = emptyString(len);
-    auto pointer = insert_string.getDataWriteable();
-    memcpy(pointer, data, len);
-    return insert_string;
-  }
-
   CiderArenaAllocator allocator_;
   size_t total_num_;
 };
@@ -23,35 +23,74 @@
 
 namespace {
 
-struct OffsetUnit {
-  unsigned dom;  // day-of-month (0-based)
-  unsigned sod;  // second-of-day
-  unsigned doe;  // day-of-era
-  unsigned yoe;  // year-of-era
-  unsigned doy;  // day-of-year
-  unsigned moy;  // month-of-year
-  unsigned moe;  // month-of-era
-};
-
 constexpr int64_t pow10[10]{1, 0, 0, 1000, 0, 0, 1000 * 1000, 0, 0, 1000 * 1000 * 1000};
-constexpr int64_t quarter[12]{1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 1, 1};
 // Number of days until Wednesday (because 2000-03-01 is a Wednesday.)
 constexpr unsigned MONDAY = 2;
 constexpr unsigned SUNDAY = 3;
 constexpr unsigned SATURDAY = 4;
 
-// Clamp day-of-month to max day of the month. E.g. April 31 -> 30.
-static unsigned clampDom(unsigned yoe, unsigned moy, unsigned dom) {
-  constexpr unsigned max_days[11]{30, 29, 30, 29, 30, 30, 29, 30, 29, 30, 30};
-  if (dom < 28) {
-    return dom;
-  } else {
-    unsigned const max_day = moy == 11
-                                 ? 27 + (++yoe % 4 == 0 && (yoe % 100 != 0 || yoe == 400))
-                                 : max_days[moy];
-    return dom < max_day ? dom : max_day;
+// Days from 0000-03-01 to 1970-01-01, split into whole eras and remaining days.
+constexpr int32_t kCivilEpochEras = 4;
+constexpr int32_t kCivilEpochDoe = 719468 - kCivilEpochEras * kDaysPer400Years;
+
+// Calendar breakdown of a date into a year starting on March 1, after Hinnant's
+// civil_from_days. Every step is 32-bit arithmetic by constants and selects without
+// branches or table lookups, so the row loop over a date column inlines and vectorizes.
+struct CivilDate {
+  int64_t year;  // year the March based year starts in
+  unsigned yoe;  // year-of-era [0, 399]
+  unsigned doy;  // day-of-year starting March 1 [0, 365]
+  unsigned moy;  // month-of-year starting March [0, 11]
+
+  explicit CivilDate(int32_t const date) {
+    int32_t era = date / kDaysPer400Years;
+    int32_t doe = date - era * kDaysPer400Years;
+    era -= doe < 0;
+    doe += (doe < 0) * kDaysPer400Years + kCivilEpochDoe;
+    era += kCivilEpochEras + (doe >= kDaysPer400Years);
+    doe -= (doe >= kDaysPer400Years) * kDaysPer400Years;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    moy = (5 * doy + 2) / 153;
+    year = static_cast<int64_t>(era) * 400 + yoe;
   }
-}
+
+  // Zero based day-of-month.
+  unsigned dom() const { return doy - (153 * moy + 2) / 5; }
+
+  int64_t extractYear() const { return year + (moy >= 10); }
+
+  int64_t extractMonth() const { return moy + 3 - 12 * (moy >= 10); }
+
+  int64_t extractDay() const { return dom() + 1; }
+
+  int64_t extractQuarter() const { return (extractMonth() + 2) / 3; }
+
+  int64_t extractDayOfYear() const {
+    unsigned const leap = yoe % 4 == 0 && (yoe % 100 != 0 || yoe == 0);
+    return doy < MARJAN ? doy + 1 + JANMAR + leap : doy + 1 - MARJAN;
+  }
+
+  // Days since 1970-01-01 of the date shifted by the given months, the day-of-month is
+  // clamped to the last day of the target month. E.g. April 31 -> 30.
+  int64_t addMonths(int64_t const months) const {
+    int64_t const total = year * 12 + moy + months;
+    int64_t const new_year = floor_div(total, 12);
+    unsigned const new_moy = total - new_year * 12;
+    int64_t const era = floor_div(new_year, 400);
+    unsigned const new_yoe = new_year - era * 400;
+    // February of the March based year falls in the next calendar year.
+    unsigned const feb_year = new_yoe + 1;
+    unsigned const feb_leap =
+        feb_year % 4 == 0 && (feb_year % 100 != 0 || feb_year == 400);
+    unsigned const month_start = (153 * new_moy + 2) / 5;
+    unsigned const month_days =
+        new_moy == 11 ? 28 + feb_leap : (153 * new_moy + 155) / 5 - month_start;
+    unsigned const day = dom() < month_days ? dom() : month_days - 1;
+    unsigned const doe = new_yoe * 365 + new_yoe / 4 - new_yoe / 100 + month_start + day;
+    return (era - kCivilEpochEras) * kDaysPer400Years + doe - kCivilEpochDoe;
+  }
+};
 
 // If OFFSET=MONDAY,
 // then return day-of-era of the Monday of ISO 8601 week 1 in the given year-of-era.
@@ -65,85 +104,29 @@ unsigned week_start_from_yoe(unsigned const yoe) {
 }
 
 class MonthDaySecond {
-  int64_t months_;  // Number of months since 2000 March 1.
   int64_t era_;
-  OffsetUnit offset_unit_;
+  unsigned doe_;  // day-of-era
+  unsigned yoe_;  // year-of-era
 
  public:
-  explicit MonthDaySecond(int32_t const date, unsigned sod = 0) {
-    offset_unit_.sod = sod;
+  explicit MonthDaySecond(int32_t const date) {
     era_ = floor_div(date - kEpochAdjustedDays, kDaysPer400Years);
-    offset_unit_.doe = date - kEpochAdjustedDays - era_ * kDaysPer400Years;
-    offset_unit_.yoe = (offset_unit_.doe - offset_unit_.doe / 1460 +
-                        offset_unit_.doe / 36524 - offset_unit_.doe / 146096) /
-                       365;
-    offset_unit_.doy = offset_unit_.doe - (365 * offset_unit_.yoe + offset_unit_.yoe / 4 -
-                                           offset_unit_.yoe / 100);
-    offset_unit_.moy = (5 * offset_unit_.doy + 2) / 153;
-    offset_unit_.dom = offset_unit_.doy - (153 * offset_unit_.moy + 2) / 5;
-    months_ = (era_ * 400 + offset_unit_.yoe) * 12 + offset_unit_.moy;
-  }
-
-  MonthDaySecond& addMonths(int64_t const months) {
-    months_ += months;
-    updateOffset();
-    return *this;
-  }
-
-  void updateOffset() {
-    era_ = floor_div(months_, 12 * 400);
-    offset_unit_.moe = months_ - era_ * (12 * 400);
-    offset_unit_.yoe = offset_unit_.moe / 12;
-    offset_unit_.moy = offset_unit_.moe % 12;
-    offset_unit_.doy = (153 * offset_unit_.moy + 2) / 5 +
-                       clampDom(offset_unit_.yoe, offset_unit_.moy, offset_unit_.dom);
-    offset_unit_.doe = offset_unit_.yoe * 365 + offset_unit_.yoe / 4 -
-                       offset_unit_.yoe / 100 + offset_unit_.doy;
-  }
-
-  // Return number of seconds since 1 January 1970.
-  int64_t getTime() const { return getDate() * kSecsPerDay + offset_unit_.sod; }
-
-  // Return dates since 1 January 1970.
-  int32_t getDate() const {
-    return (kEpochAdjustedDays + era_ * kDaysPer400Years + offset_unit_.doe);
-  }
-
-  int64_t extractYear() const {
-    return 2000 + era_ * 400 + offset_unit_.yoe + (MARJAN <= offset_unit_.doy);
-  }
-
-  int64_t extractDay() const {
-    return offset_unit_.doy - (153 * offset_unit_.moy + 2) / 5 + 1;
-  }
-
-  int64_t extractMonth() const {
-    return offset_unit_.moy + (offset_unit_.moy < 10 ? 3 : -9);
-  }
-
-  int64_t extractQuarter() const { return quarter[offset_unit_.moy]; }
-
-  int64_t extractDayOfYear() const {
-    return offset_unit_.doy +
-           (offset_unit_.doy < MARJAN
-                ? 1 + JANMAR +
-                      (offset_unit_.yoe % 4 == 0 &&
-                       (offset_unit_.yoe % 100 != 0 || offset_unit_.yoe == 0))
-                : 1 - MARJAN);
+    doe_ = date - kEpochAdjustedDays - era_ * kDaysPer400Years;
+    yoe_ = (doe_ - doe_ / 1460 + doe_ / 36524 - doe_ / 146096) / 365;
   }
 
   template <unsigned OFFSET>
   int64_t extract_week() const {
-    unsigned week_start = week_start_from_yoe<OFFSET>(offset_unit_.yoe);
-    if (offset_unit_.doe < week_start) {
-      if (offset_unit_.yoe == 0) {
+    unsigned week_start = week_start_from_yoe<OFFSET>(yoe_);
+    if (doe_ < week_start) {
+      if (yoe_ == 0) {
         // 2000-03-01 is OFFSET days from start of week, week + 9.
-        return (offset_unit_.doe + OFFSET) / 7 + 9;
+        return (doe_ + OFFSET) / 7 + 9;
       } else {
-        week_start = week_start_from_yoe<OFFSET>(offset_unit_.yoe - 1);
+        week_start = week_start_from_yoe<OFFSET>(yoe_ - 1);
       }
     }
-    return (offset_unit_.doe - week_start) / 7 + 1;
+    return (doe_ - week_start) / 7 + 1;
   }
 };
 
@@ -164,13 +147,13 @@ extern "C" ALWAYS_INLINE int64_t time_add_seconds(const int64_t time,
 
 extern "C" ALWAYS_INLINE int32_t date_add_months(const int32_t date,
                                                  const int64_t interval) {
-  return MonthDaySecond(date).addMonths(interval).getDate();
+  return CivilDate(date).addMonths(interval);
 }
 
 extern "C" ALWAYS_INLINE int64_t time_add_months(const int64_t time,
                                                  const int64_t interval) {
   int64_t const date = floor_div(time, kSecsPerDay);
-  return MonthDaySecond(date, time - date * kSecsPerDay).addMonths(interval).getTime();
+  return CivilDate(date).addMonths(interval) * kSecsPerDay + (time - date * kSecsPerDay);
 }
 
 extern "C" ALWAYS_INLINE int64_t time_add_months_high_precision(const int64_t time,
@@ -191,11 +174,11 @@ extern "C" ALWAYS_INLINE int64_t time_add_seconds_high_precision(const int64_t t
 
 // date extract  (days~year)
 extern "C" ALWAYS_INLINE int64_t date_extract_year(const int32_t date) {
-  return MonthDaySecond(date).extractYear();
+  return CivilDate(date).extractYear();
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_day(const int32_t date) {
-  return MonthDaySecond(date).extractDay();
+  return CivilDate(date).extractDay();
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_dow(const int32_t date) {
@@ -207,15 +190,15 @@ extern "C" ALWAYS_INLINE int64_t date_extract_isodow(const int32_t date) {
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_month(const int32_t date) {
-  return MonthDaySecond(date).extractMonth();
+  return CivilDate(date).extractMonth();
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_quarter(const int32_t date) {
-  return MonthDaySecond(date).extractQuarter();
+  return CivilDate(date).extractQuarter();
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_day_of_year(const int32_t date) {
-  return MonthDaySecond(date).extractDayOfYear();
+  return CivilDate(date).extractDayOfYear();
 }
 
 extern "C" ALWAYS_INLINE int64_t date_extract_week_monday(const int32_t date) {
@@ -258,11 +241,11 @@ extern "C" ALWAYS_INLINE int64_t time_extract_isodow(const int64_t time) {
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_day_of_year(const int64_t time) {
-  return MonthDaySecond(floor_div(time, kSecsPerDay)).extractDayOfYear();
+  return CivilDate(floor_div(time, kSecsPerDay)).extractDayOfYear();
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_day(const int64_t time) {
-  return MonthDaySecond(floor_div(time, kSecsPerDay)).extractDay();
+  return CivilDate(floor_div(time, kSecsPerDay)).extractDay();
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_week_monday(const int64_t time) {
@@ -270,13 +253,13 @@ extern "C" ALWAYS_INLINE int64_t time_extract_week_monday(const int64_t time) {
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_month(const int64_t time) {
-  return MonthDaySecond(floor_div(time, kSecsPerDay)).extractMonth();
+  return CivilDate(floor_div(time, kSecsPerDay)).extractMonth();
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_quarter(const int64_t time) {
-  return MonthDaySecond(floor_div(time, kSecsPerDay)).extractQuarter();
+  return CivilDate(floor_div(time, kSecsPerDay)).extractQuarter();
 }
 
 extern "C" ALWAYS_INLINE int64_t time_extract_year(const int64_t time) {
-  return MonthDaySecond(floor_div(time, kSecsPerDay)).extractYear();
+  return CivilDate(floor_div(time, kSecsPerDay)).extractYear();
 }
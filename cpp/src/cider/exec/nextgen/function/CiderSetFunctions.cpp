@@ -26,7 +26,7 @@
                                                                 const type val) { \
     auto cider_set =                                                              \
         reinterpret_cast<cider::exec::nextgen::context::CiderInt64Set*>(set_ptr); \
-    return cider_set->contains(val);                                              \
+    return cider_set->find(val);                                                  \
   }
 
 DEF_CIDER_INT64_SET_CONTAINS(int8_t)
@@ -34,12 +34,25 @@ DEF_CIDER_INT64_SET_CONTAINS(int16_t)
 DEF_CIDER_INT64_SET_CONTAINS(int32_t)
 DEF_CIDER_INT64_SET_CONTAINS(int64_t)
 
+#define DEF_CIDER_BITMAP_SET_CONTAINS(type)                                        \
+  extern "C" ALWAYS_INLINE bool cider_bitmap_set_contains_##type##_val(            \
+      int8_t* set_ptr, const type val) {                                           \
+    auto cider_set =                                                               \
+        reinterpret_cast<cider::exec::nextgen::context::CiderBitmapSet*>(set_ptr); \
+    return cider_set->find(val);                                                   \
+  }
+
+DEF_CIDER_BITMAP_SET_CONTAINS(int8_t)
+DEF_CIDER_BITMAP_SET_CONTAINS(int16_t)
+DEF_CIDER_BITMAP_SET_CONTAINS(int32_t)
+DEF_CIDER_BITMAP_SET_CONTAINS(int64_t)
+
 #define DEF_CIDER_DOUBLE_SET_CONTAINS(type)                                        \
   extern "C" ALWAYS_INLINE bool cider_set_contains_##type##_val(int8_t* set_ptr,   \
                                                                 const type val) {  \
     auto cider_set =                                                               \
         reinterpret_cast<cider::exec::nextgen::context::CiderDoubleSet*>(set_ptr); \
-    return cider_set->contains(val);                                               \
+    return cider_set->find(val);                                                   \
   }
 
 DEF_CIDER_DOUBLE_SET_CONTAINS(float)
@@ -50,6 +63,14 @@ extern "C" ALWAYS_INLINE bool cider_set_contains_string_val(int8_t* set_ptr,
                                                             int len) {
   auto cider_set =
       reinterpret_cast<cider::exec::nextgen::context::CiderStringSet*>(set_ptr);
-  std::string val_str(str, len);
-  return cider_set->contains(val_str);
+  return cider_set->find(str, len);
+}
+
+// Exact equality used by short IN lists, the length check lets a constant literal
+// reject most rows before touching any bytes.
+extern "C" ALWAYS_INLINE bool cider_string_eq_literal(const char* str,
+                                                      int len,
+                                                      const char* literal,
+                                                      int literal_len) {
+  return len == literal_len && 0 == memcmp(str, literal, len);
 }
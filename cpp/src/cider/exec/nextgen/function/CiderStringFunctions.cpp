@@ -22,10 +22,14 @@
 #include <re2/re2.h>
 #include <string.h>
 #include <algorithm>
+#include <memory>
+#include <string_view>
 #include "exec/module/batch/ArrowABI.h"
 #include "exec/module/batch/CiderArrowBufferHolder.h"
 #include "exec/nextgen/context/StringHeap.h"
+#include "util/CiderCpuDispatch.h"
 #include "util/DateTimeParser.h"
+#include "util/DecimalString.h"
 #include "util/misc.h"
 
 ALWAYS_INLINE uint64_t pack_string(const int8_t* ptr, const int32_t len) {
@@ -33,26 +37,17 @@ ALWAYS_INLINE uint64_t pack_string(const int8_t* ptr, const int32_t len) {
          (static_cast<const uint64_t>(len) << 48);
 }
 
-ALWAYS_INLINE uint64_t pack_string_t(const string_t& s) {
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+// Copies a result string to the heap, which outlives the packed pointer.
+ALWAYS_INLINE uint64_t pack_heap_string(StringHeap* heap, const char* str, int32_t len) {
+  return pack_string((const int8_t*)heap->addStringData(str, len), len);
 }
 
-// not in use.
-extern "C" RUNTIME_EXPORT int64_t cider_substring(const char* str, int pos, int len) {
+// pos parameter starts from 1 rather than 0, the substring is a view of str.
+extern "C" ALWAYS_INLINE int64_t cider_substring(const char* str, int pos, int len) {
   const char* ret_ptr = str + pos - 1;
   return pack_string((const int8_t*)ret_ptr, (const int32_t)len);
 }
 
-// pos parameter starts from 1 rather than 0
-extern "C" RUNTIME_EXPORT int64_t cider_substring_extra(char* string_heap_ptr,
-                                                        const char* str,
-                                                        int pos,
-                                                        int len) {
-  StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(str + pos - 1, len);
-  return pack_string_t(s);
-}
-
 // pos starts with 1. A negative starting position is interpreted as being relative
 // to the end of the string
 extern "C" RUNTIME_EXPORT int32_t format_substring_pos(int pos, int str_len) {
@@ -138,24 +133,38 @@ extern "C" ALWAYS_INLINE int64_t cider_ascii_lower(int8_t* string_heap_ptr,
                                                    const char* str,
                                                    int str_len) {
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->emptyString(str_len);
-  char* sout = s.getDataWriteable();
+  char* sout = ptr->allocateStringData(str_len);
   for (int i = 0; i < str_len; ++i) {
     sout[i] = ascii_char_lower_map[reinterpret_cast<const uint8_t*>(str)[i]];
   }
-  return pack_string_t(s);
+  return pack_string((const int8_t*)sout, str_len);
 }
 
 extern "C" ALWAYS_INLINE int64_t cider_ascii_upper(int8_t* string_heap_ptr,
                                                    const char* str,
                                                    int str_len) {
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->emptyString(str_len);
-  char* sout = s.getDataWriteable();
+  char* sout = ptr->allocateStringData(str_len);
   for (int i = 0; i < str_len; ++i) {
     sout[i] = ascii_char_upper_map[reinterpret_cast<const uint8_t*>(str)[i]];
   }
-  return pack_string_t(s);
+  return pack_string((const int8_t*)sout, str_len);
+}
+
+// Maps a string in the data buffer at base to the same offset of the buffer at new_base.
+extern "C" ALWAYS_INLINE int8_t* cider_rebase_string_ptr(const int8_t* str_ptr,
+                                                         const int8_t* base,
+                                                         int8_t* new_base) {
+  return new_base + (str_ptr - base);
+}
+
+// Looks up the result of a dictionary predicate of a string in the dictionary data
+// buffer at base (see RuntimeContext::getDictionaryPredicateResults).
+extern "C" ALWAYS_INLINE bool cider_dictionary_predicate_result(const int8_t* results,
+                                                                const int8_t* str_ptr,
+                                                                int32_t str_len,
+                                                                const int8_t* base) {
+  return results[str_len ? str_ptr - base + 1 : 0];
 }
 
 extern "C" void test_to_string(int value) {
@@ -168,13 +177,11 @@ extern "C" ALWAYS_INLINE int64_t cider_concat(char* string_heap_ptr,
                                               const char* rhs,
                                               int rhs_len) {
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->emptyString(lhs_len + rhs_len);
-
-  char* buffer_ptr = s.getDataWriteable();
+  char* buffer_ptr = ptr->allocateStringData(lhs_len + rhs_len);
   memcpy(buffer_ptr, lhs, lhs_len);
   memcpy(buffer_ptr + lhs_len, rhs, rhs_len);
 
-  return pack_string_t(s);
+  return pack_string((const int8_t*)buffer_ptr, lhs_len + rhs_len);
 }
 
 // to be deprecated.
@@ -190,13 +197,11 @@ extern "C" ALWAYS_INLINE int64_t cider_rconcat(char* string_heap_ptr,
                                                const char* rhs,
                                                int rhs_len) {
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->emptyString(lhs_len + rhs_len);
-
-  char* buffer_ptr = s.getDataWriteable();
+  char* buffer_ptr = ptr->allocateStringData(lhs_len + rhs_len);
   memcpy(buffer_ptr, rhs, rhs_len);
   memcpy(buffer_ptr + rhs_len, lhs, lhs_len);
 
-  return pack_string_t(s);
+  return pack_string((const int8_t*)buffer_ptr, lhs_len + rhs_len);
 }
 
 extern "C" ALWAYS_INLINE int8_t* get_data_buffer_with_realloc_on_demand(
@@ -220,14 +225,58 @@ extern "C" ALWAYS_INLINE int8_t* get_data_buffer_with_realloc_on_demand(
   return holder->getBufferAs<int8_t>(2);
 }
 
-extern "C" ALWAYS_INLINE int64_t cider_trim(char* string_heap_ptr,
-                                            const char* str_ptr,
+// Allocates the variadic data buffer (buffer 2) and its sizes buffer (buffer 3) of a
+// Utf8View array, so both exist even if no string is longer than 12 bytes.
+extern "C" ALWAYS_INLINE void init_string_view_buffers(int8_t* output_desc_ptr) {
+  ArrowArray* arrow_array = reinterpret_cast<ArrowArray*>(output_desc_ptr);
+  CiderArrowArrayBufferHolder* holder =
+      reinterpret_cast<CiderArrowArrayBufferHolder*>(arrow_array->private_data);
+  holder->allocBuffer(2, std::max<size_t>(holder->getBufferSizeAt(2), 1));
+  holder->allocBuffer(3, sizeof(int64_t));
+  *holder->getBufferAs<int64_t>(3) = 0;
+}
+
+// Writes the Utf8View of row index, strings longer than 12 bytes are appended to the
+// single variadic data buffer (buffer 2) whose used bytes are kept in buffer 3. See
+// init_string_view_buffers.
+extern "C" ALWAYS_INLINE void write_string_view(int8_t* output_desc_ptr,
+                                                int8_t* views,
+                                                const int64_t index,
+                                                const char* str,
+                                                const int32_t str_len,
+                                                const bool is_null) {
+  constexpr int32_t kInlineLength = 12;
+  int32_t* view = reinterpret_cast<int32_t*>(views) + index * 4;
+  std::memset(view, 0, 16);
+  const int32_t len = is_null ? 0 : str_len;
+  view[0] = len;
+  if (len <= kInlineLength) {
+    std::memcpy(view + 1, str, len);
+    return;
+  }
+
+  ArrowArray* arrow_array = reinterpret_cast<ArrowArray*>(output_desc_ptr);
+  CiderArrowArrayBufferHolder* holder =
+      reinterpret_cast<CiderArrowArrayBufferHolder*>(arrow_array->private_data);
+  int64_t used_bytes = *holder->getBufferAs<int64_t>(3);
+  size_t capacity = holder->getBufferSizeAt(2);
+  size_t required = used_bytes + len;
+  if (required > capacity) {
+    holder->allocBuffer(2, std::max<size_t>({capacity * 2, required, 4096}));
+  }
+  std::memcpy(holder->getBufferAs<int8_t>(2) + used_bytes, str, len);
+  std::memcpy(view + 1, str, 4);
+  view[2] = 0;
+  view[3] = used_bytes;
+  *holder->getBufferAs<int64_t>(3) = used_bytes + len;
+}
+
+// Trimmed string is a view of the input string.
+extern "C" ALWAYS_INLINE int64_t cider_trim(const char* str_ptr,
                                             int str_len,
                                             const int8_t* trim_char_map,
                                             bool ltrim,
                                             bool rtrim) {
-  StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-
   int start_idx = 0;
   if (ltrim) {
     while (start_idx < str_len &&
@@ -252,17 +301,17 @@ extern "C" ALWAYS_INLINE int64_t cider_trim(char* string_heap_ptr,
     len = end_idx - start_idx + 1;
   }
 
-  string_t s = ptr->addString(str_ptr + start_idx, len);
-  return pack_string_t(s);
+  return pack_string(reinterpret_cast<const int8_t*>(str_ptr) + start_idx, len);
 }
 
 #define DEF_CONVERT_INTEGER_TO_STRING(value_type, value_name)                         \
   extern "C" RUNTIME_EXPORT int64_t gen_string_from_##value_name(                     \
       const value_type operand, char* string_heap_ptr) {                              \
-    std::string str = std::to_string(operand);                                        \
+    constexpr size_t buf_size = 24;                                                   \
+    char buf[buf_size];                                                               \
+    int32_t str_len = decimal_string::formatInt64(operand, buf + buf_size);           \
     StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);                 \
-    string_t s = ptr->addString(str.data(), str.length());                            \
-    return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize()); \
+    return pack_heap_string(ptr, buf + buf_size - str_len, str_len);                  \
   }
 DEF_CONVERT_INTEGER_TO_STRING(int8_t, tinyint)
 DEF_CONVERT_INTEGER_TO_STRING(int16_t, smallint)
@@ -272,26 +321,27 @@ DEF_CONVERT_INTEGER_TO_STRING(int64_t, bigint)
 
 extern "C" RUNTIME_EXPORT NEVER_INLINE int64_t
 gen_string_from_float(const float operand, char* string_heap_ptr) {
-  std::string str = fmt::format("{:#}", operand);
+  constexpr size_t buf_size = 64;
+  char buf[buf_size];
+  auto result = fmt::format_to_n(buf, buf_size, "{:#}", operand);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(str.data(), str.length());
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return pack_heap_string(ptr, buf, result.size);
 }
 
 extern "C" RUNTIME_EXPORT NEVER_INLINE int64_t
 gen_string_from_double(const double operand, char* string_heap_ptr) {
-  std::string str = fmt::format("{:#}", operand);
+  constexpr size_t buf_size = 64;
+  char buf[buf_size];
+  auto result = fmt::format_to_n(buf, buf_size, "{:#}", operand);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(str.data(), str.length());
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return pack_heap_string(ptr, buf, result.size);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
 gen_string_from_bool(const int8_t operand, char* string_heap_ptr) {
-  std::string str = (operand == 1) ? "true" : "false";
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(str.data(), str.length());
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return operand == 1 ? pack_heap_string(ptr, "true", 4)
+                      : pack_heap_string(ptr, "false", 5);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
@@ -302,8 +352,7 @@ gen_string_from_time(const int64_t operand,
   char buf[buf_size];
   int32_t str_len = shared::formatHMS(buf, buf_size, operand, dimension);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(buf, str_len);
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return pack_heap_string(ptr, buf, str_len);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
@@ -314,8 +363,7 @@ gen_string_from_timestamp(const int64_t operand,
   char buf[buf_size];
   int32_t str_len = shared::formatDateTime(buf, buf_size, operand, dimension);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(buf, str_len);
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return pack_heap_string(ptr, buf, str_len);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
@@ -324,15 +372,13 @@ gen_string_from_date(const int32_t operand, char* string_heap_ptr) {
   char buf[buf_size];
   int32_t str_len = shared::formatDays(buf, buf_size, operand);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  string_t s = ptr->addString(buf, str_len);
-  return pack_string((const int8_t*)s.getDataUnsafe(), (const int32_t)s.getSize());
+  return pack_heap_string(ptr, buf, str_len);
 }
 
 #define DEF_CONVERT_STRING_TO_INTEGER(value_type, value_name)                   \
   extern "C" RUNTIME_EXPORT value_type convert_string_to_##value_name(          \
       const char* str_ptr, const int32_t str_len) {                             \
-    std::string from_str(str_ptr, str_len);                                     \
-    value_type res = std::stoi(from_str);                                       \
+    int64_t res = decimal_string::parseInt64(str_ptr, str_len);                 \
     if (res > std::numeric_limits<value_type>::min() &&                         \
         res <= std::numeric_limits<value_type>::max())                          \
       return res;                                                               \
@@ -347,13 +393,16 @@ DEF_CONVERT_STRING_TO_INTEGER(int32_t, int)
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
 convert_string_to_bigint(const char* str_ptr, const int32_t str_len) {
-  std::string from_str(str_ptr, str_len);
-  return std::stoll(from_str);
+  return decimal_string::parseInt64(str_ptr, str_len);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE float convert_string_to_float(
     const char* str_ptr,
     const int32_t str_len) {
+  float result;
+  if (decimal_string::parseSimpleFloat(str_ptr, str_len, result)) {
+    return result;
+  }
   std::string from_str(str_ptr, str_len);
   return std::stof(from_str);
 }
@@ -372,13 +421,20 @@ extern "C" RUNTIME_EXPORT int8_t convert_string_to_bool(const char* str_ptr,
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE double convert_string_to_double(
     const char* str_ptr,
     const int32_t str_len) {
+  double result;
+  if (decimal_string::parseSimpleDouble(str_ptr, str_len, result)) {
+    return result;
+  }
   std::string from_str(str_ptr, str_len);
   return std::stod(from_str);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int32_t
 convert_string_to_date(const char* str_ptr, const int32_t str_len) {
-  std::string from_str(str_ptr, str_len);
+  std::string_view from_str(str_ptr, str_len);
+  if (auto days = iso_datetime::parseDateInDays(from_str)) {
+    return *days;
+  }
   return parseDateInDays(from_str);
 }
 
@@ -386,13 +442,19 @@ extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
 convert_string_to_timestamp(const char* str_ptr,
                             const int32_t str_len,
                             const int32_t dim) {
-  std::string from_str(str_ptr, str_len);
+  std::string_view from_str(str_ptr, str_len);
+  if (auto timestamp = iso_datetime::parseTimestamp(from_str, dim)) {
+    return *timestamp;
+  }
   return dateTimeParse<kTIMESTAMP>(from_str, dim);
 }
 
 extern "C" RUNTIME_EXPORT ALWAYS_INLINE int64_t
 convert_string_to_time(const char* str_ptr, const int32_t str_len, const int32_t dim) {
-  std::string from_str(str_ptr, str_len);
+  std::string_view from_str(str_ptr, str_len);
+  if (auto time = iso_datetime::parseTime(from_str, dim)) {
+    return *time;
+  }
   return dateTimeParse<kTIME>(from_str, dim);
 }
 
@@ -406,12 +468,13 @@ extern "C" ALWAYS_INLINE size_t cider_find_str_from_left(const char* str1,
     return npos;
   }
   size_t real_start_pos = (start_pos == npos) ? 0 : start_pos;
-  for (size_t i = real_start_pos; i < str1_len - str2_len; ++i) {
-    if (!std::memcmp(str1 + i, str2, str2_len)) {
-      return i;
-    }
+  // candidates are the positions in [real_start_pos, str1_len - str2_len)
+  if (real_start_pos >= str1_len - str2_len) {
+    return npos;
   }
-  return npos;
+  int64_t pos = CiderCpuDispatch::getKernels().find_str(
+      str1 + real_start_pos, str1_len - 1 - real_start_pos, str2, str2_len);
+  return pos < 0 ? npos : real_start_pos + pos;
 }
 
 extern "C" ALWAYS_INLINE size_t cider_find_str_from_right(const char* str1,
@@ -423,12 +486,10 @@ extern "C" ALWAYS_INLINE size_t cider_find_str_from_right(const char* str1,
     return npos;
   }
   size_t real_start_pos = (start_pos == npos) ? 0 : start_pos;
-  for (size_t i = real_start_pos; i >= str2_len; --i) {
-    if (!std::memcmp(str1 + i - str2_len, str2, str2_len)) {
-      return i - str2_len;
-    }
-  }
-  return npos;
+  // last match ending at or before real_start_pos
+  auto pos = std::string_view(str1, std::min(real_start_pos, str1_len))
+                 .rfind(std::string_view(str2, str2_len));
+  return pos == std::string_view::npos ? npos : pos;
 }
 
 // Split a string into a list of strings, based on a specified `separator` character.
@@ -452,15 +513,13 @@ extern "C" ALWAYS_INLINE int64_t cider_split(char* string_heap_ptr,
   split_part = split_part == 0 ? 1UL : std::abs(split_part);
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
   if (delimiter_len == 0) {
-    string_t s = ptr->addString(str_ptr, str_len);
-    return pack_string_t(s);
+    return pack_heap_string(ptr, str_ptr, str_len);
   }
 
   if (limit == 1) {
     // should return a list with only 1 string (which should not be splitted)
     if (split_part == 1) {
-      string_t s = ptr->addString(str_ptr, str_len);
-      return pack_string_t(s);
+      return pack_heap_string(ptr, str_ptr, str_len);
     } else {
       // out of range, should return null;
       return 0;
@@ -498,8 +557,7 @@ extern "C" ALWAYS_INLINE int64_t cider_split(char* string_heap_ptr,
 
   if (delimiter_idx == 0 && split_part == 1) {
     // delimiter does not exist, but the first split is requested, return the entire str
-    string_t s = ptr->addString(str_ptr, str_len);
-    return pack_string_t(s);
+    return pack_heap_string(ptr, str_ptr, str_len);
   }
 
   if (delimiter_pos == npos &&
@@ -511,9 +569,8 @@ extern "C" ALWAYS_INLINE int64_t cider_split(char* string_heap_ptr,
   if (reverse) {
     const size_t substr_start =
         delimiter_pos == npos ? 0UL : delimiter_pos + delimiter_len;
-    string_t s =
-        ptr->addString(str_ptr + substr_start, last_delimiter_pos - substr_start);
-    return pack_string_t(s);
+    return pack_heap_string(
+        ptr, str_ptr + substr_start, last_delimiter_pos - substr_start);
   } else {
     const size_t substr_start =
         split_part == 1UL ? 0UL : last_delimiter_pos + delimiter_len;
@@ -524,18 +581,15 @@ extern "C" ALWAYS_INLINE int64_t cider_split(char* string_heap_ptr,
       len = delimiter_pos - substr_start;
     }
 
-    string_t s = ptr->addString(str_ptr + substr_start, len);
-    return pack_string_t(s);
+    return pack_heap_string(ptr, str_ptr + substr_start, len);
   }
 }
 
 std::pair<size_t, size_t> cider_find_nth_regex_match(const char* input_ptr,
                                                      int input_len,
-                                                     const re2::StringPiece& pattern,
+                                                     const RE2& re,
                                                      int start_pos,
                                                      int occurrence) {
-  RE2 re(pattern);
-
   // record start_pos and length for each matched substring
   std::vector<std::pair<size_t, size_t>> matched_pos;
   int string_pos = start_pos;
@@ -571,56 +625,61 @@ std::pair<size_t, size_t> cider_find_nth_regex_match(const char* input_ptr,
 // Search a string for a substring that matches a given regular expression pattern and
 // replace it with a replacement string.
 // str_ptr & str_len: input string.
-// regex_pattern_ptr & regex_pattern_len: the regular expression to search for within the
-// input string.
+// regex: the compiled regular expression to search for within the input string.
 // replace_ptr & replace_len: the replacement string.
 // start_pos: the position to start the search.
 // occurrence: which occurrence of the match to replace.
 extern "C" ALWAYS_INLINE int64_t cider_regexp_replace(char* string_heap_ptr,
                                                       const char* str_ptr,
                                                       int str_len,
-                                                      const char* regex_pattern_ptr,
-                                                      int regex_pattern_len,
+                                                      const int8_t* regex,
                                                       const char* replace_ptr,
                                                       const int replace_len,
                                                       int start_pos,
                                                       int occurrence) {
   start_pos = start_pos > 0 ? start_pos - 1 : start_pos;
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
+  const RE2& re = *reinterpret_cast<const RE2*>(regex);
   const size_t wrapped_start = static_cast<size_t>(
       std::min(start_pos >= 0 ? start_pos : std::max(str_len + start_pos, 0), str_len));
-  // construct for re2 lib - first memory copy
-  std::string input(str_ptr + wrapped_start, str_len - wrapped_start);
-  re2::StringPiece pattern(regex_pattern_ptr, regex_pattern_len);
   re2::StringPiece replace(replace_ptr, replace_len);
   if (occurrence == 0L) {
     // occurrence_ == 0: replace all occurrences
-    int cnt = RE2::GlobalReplace(&input, pattern, replace);
-    string_t res = ptr->emptyString(wrapped_start + input.length());
+    // rows without a match are returned without copying the input for re2, the match
+    // is tried on the same text as GlobalReplace so that anchors agree.
+    re2::StringPiece text(str_ptr + wrapped_start, str_len - wrapped_start);
+    if (!re.Match(text, 0, text.size(), RE2::UNANCHORED, nullptr, 0)) {
+      return pack_heap_string(ptr, str_ptr, str_len);
+    }
+    // construct for re2 lib - first memory copy
+    std::string input(str_ptr + wrapped_start, str_len - wrapped_start);
+    int cnt = RE2::GlobalReplace(&input, re, replace);
+    int32_t res_len = wrapped_start + input.length();
+    char* res = ptr->allocateStringData(res_len);
     // construct result string - second memory copy
-    std::memcpy(res.getDataWriteable(), str_ptr, wrapped_start);
-    std::memcpy(res.getDataWriteable() + wrapped_start, input.c_str(), input.length());
-    return pack_string_t(res);
+    std::memcpy(res, str_ptr, wrapped_start);
+    std::memcpy(res + wrapped_start, input.c_str(), input.length());
+    return pack_string((const int8_t*)res, res_len);
   } else {
     // only replace n-th occurrence
     std::pair<size_t, size_t> match_pos =
         cider_find_nth_regex_match(str_ptr,
                                    str_len,
-                                   pattern,
+                                   re,
                                    start_pos,
                                    occurrence > 0 ? occurrence - 1 : occurrence);
     if (match_pos.first == npos) {
       // no match found, return origin string
-      string_t res = ptr->addString(str_ptr, str_len);
-      return pack_string_t(res);
+      return pack_heap_string(ptr, str_ptr, str_len);
     } else {
-      string_t res = ptr->emptyString(str_len - match_pos.second + replace_len);
-      std::memcpy(res.getDataWriteable(), str_ptr, match_pos.first);
-      std::memcpy(res.getDataWriteable() + match_pos.first, replace_ptr, replace_len);
-      std::memcpy(res.getDataWriteable() + match_pos.first + replace_len,
+      int32_t res_len = str_len - match_pos.second + replace_len;
+      char* res = ptr->allocateStringData(res_len);
+      std::memcpy(res, str_ptr, match_pos.first);
+      std::memcpy(res + match_pos.first, replace_ptr, replace_len);
+      std::memcpy(res + match_pos.first + replace_len,
                   str_ptr + match_pos.first + match_pos.second,
                   str_len - (match_pos.first + match_pos.second));
-      return pack_string_t(res);
+      return pack_string((const int8_t*)res, res_len);
     }
   }
 
@@ -630,46 +689,51 @@ extern "C" ALWAYS_INLINE int64_t cider_regexp_replace(char* string_heap_ptr,
 extern "C" ALWAYS_INLINE int64_t cider_regexp_extract(char* string_heap_ptr,
                                                       const char* str_ptr,
                                                       int str_len,
-                                                      const char* regex_pattern_ptr,
-                                                      int regex_pattern_len,
+                                                      const int8_t* regex,
                                                       int group) {
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
+  const RE2& re = *reinterpret_cast<const RE2*>(regex);
+
+  // same as RE2::Extract with rewrite "\\<group>", but the matched group is viewed in
+  // the input instead of being copied to a std::string. Submatches of up to kMaxGroups
+  // groups are kept on the stack.
+  constexpr int kMaxGroups = 16;
+  re2::StringPiece stack_groups[kMaxGroups + 1];
+  std::vector<re2::StringPiece> heap_groups;
+  re2::StringPiece* groups = stack_groups;
+  if (group > kMaxGroups) {
+    heap_groups.resize(group + 1);
+    groups = heap_groups.data();
+  }
+  if (group < 0 || group > re.NumberOfCapturingGroups() ||
+      !re.Match(re2::StringPiece(str_ptr, str_len),
+                0,
+                str_len,
+                RE2::UNANCHORED,
+                groups,
+                group + 1)) {
+    return pack_string((const int8_t*)ptr->allocateStringData(0), 0);
+  }
 
-  std::string group_string = "\\" + std::to_string(group);
-  std::string out;
-  re2::StringPiece input(str_ptr, str_len);
-  re2::StringPiece pattern(regex_pattern_ptr, regex_pattern_len);
-  RE2 re(pattern);
-  RE2::Extract(input, re, group_string, &out);
-
-  string_t res = ptr->addString(out.c_str(), out.length());
-  return pack_string_t(res);
+  return pack_heap_string(ptr, groups[group].data(), groups[group].size());
 }
 
 extern "C" ALWAYS_INLINE int64_t cider_regexp_substring(char* string_heap_ptr,
                                                         const char* str_ptr,
                                                         int str_len,
-                                                        const char* regex_pattern_ptr,
-                                                        int regex_pattern_len,
+                                                        const int8_t* regex,
                                                         int occurrence,
                                                         int start_pos) {
   start_pos = start_pos > 0 ? start_pos - 1 : str_len + start_pos;
   StringHeap* ptr = reinterpret_cast<StringHeap*>(string_heap_ptr);
-  const size_t wrapped_start = static_cast<size_t>(
-      std::min(start_pos >= 0 ? start_pos : std::max(str_len + start_pos, 0), str_len));
-  std::string input(str_ptr + wrapped_start, str_len - wrapped_start);
-  re2::StringPiece pattern(regex_pattern_ptr, regex_pattern_len);
+  const RE2& re = *reinterpret_cast<const RE2*>(regex);
 
   std::pair<size_t, size_t> match_pos = cider_find_nth_regex_match(
-      str_ptr, str_len, pattern, start_pos, occurrence > 0 ? occurrence - 1 : occurrence);
+      str_ptr, str_len, re, start_pos, occurrence > 0 ? occurrence - 1 : occurrence);
   if (match_pos.first == npos) {
     // no match found, return empty
-    string_t res = ptr->emptyString(0);
-    return pack_string_t(res);
+    return pack_string((const int8_t*)ptr->allocateStringData(0), 0);
   } else {
-    string_t res = ptr->emptyString(match_pos.second);
-    std::memcpy(res.getDataWriteable(), str_ptr + match_pos.first, match_pos.second);
-
-    return pack_string_t(res);
+    return pack_heap_string(ptr, str_ptr + match_pos.first, match_pos.second);
   }
 }
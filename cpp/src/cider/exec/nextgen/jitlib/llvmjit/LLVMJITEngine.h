@@ -23,6 +23,8 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 
+#include "util/CiderCpuDispatch.h"
+
 namespace cider::jitlib {
 class LLVMJITModule;
 
@@ -32,8 +34,13 @@ struct CompilationOptions {
   bool aggressive_jit_compile = true;
   bool dump_ir = false;
   bool enable_vectorize = false;
-  bool enable_avx2 = true;
-  bool enable_avx512 = false;
+  // Follow the ISA level selected for native runtime kernels by default.
+  bool enable_avx2 =
+      CiderCpuDispatch::getIsaLevel() >= CiderCpuDispatch::IsaLevel::kAVX2;
+  bool enable_avx512 =
+      CiderCpuDispatch::getIsaLevel() >= CiderCpuDispatch::IsaLevel::kAVX512;
+  // Log runtime functions which are inlined or still called after IR optimization.
+  bool report_inlining = false;
 };
 
 struct LLVMJITEngine {
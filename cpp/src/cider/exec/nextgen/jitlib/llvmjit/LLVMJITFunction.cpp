@@ -209,6 +209,7 @@ JITValuePointer LLVMJITFunction::emitRuntimeFunctionCall(
   if (!func) {
     LOG(ERROR) << "Function: " << fname << " does not exist.";
   }
+  module_.referenced_runtime_functions_.insert(fname);
   cloneFunctionRecursive(func);
 
   llvm::SmallVector<llvm::Value*, JITFunctionEmitDescriptor::DefaultParamsNum> args;
@@ -249,7 +250,7 @@ void LLVMJITFunction::cloneFunctionRecursive(llvm::Function* fn) {
                           func_impl,
                           module_.vmap_,
                           llvm::CloneFunctionChangeType::DifferentModule,
-                          Returns);
+                          returns);
 #else
   llvm::CloneFunctionInto(
       fn, func_impl, module_.vmap_, /*ModuleLevelChanges=*/true, returns);
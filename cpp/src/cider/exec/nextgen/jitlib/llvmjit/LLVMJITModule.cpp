@@ -25,12 +25,15 @@
 #include <llvm/Analysis/CGSCCPassManager.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
 #include <llvm/Transforms/IPO/GlobalOpt.h>
+#include <llvm/Transforms/IPO/StripDeadPrototypes.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar/LoopPassManager.h>
 #include <llvm/Transforms/Scalar/LoopRotation.h>
@@ -47,6 +50,7 @@
 #include "exec/nextgen/jitlib/llvmjit/LLVMJITTargets.h"
 #include "exec/nextgen/jitlib/llvmjit/LLVMJITUtils.h"
 #include "util/Logger.h"
+#include "util/StringTransform.h"
 #include "util/filesystem/cider_path.h"
 
 namespace cider::jitlib {
@@ -182,6 +186,11 @@ void LLVMJITModule::finish(const std::string& main_func) {
   // IR optimization
   optimizeIR(tm);
 
+  if (co_.report_inlining) {
+    buildInliningReport();
+  }
+  vectorized_loop_num_ = countVectorizedLoops();
+
   LLVMJITEngineBuilder builder(*this, tm);
 
   if (co_.dump_ir) {
@@ -193,6 +202,8 @@ void LLVMJITModule::finish(const std::string& main_func) {
 
 void LLVMJITModule::optimizeIR(llvm::TargetMachine* tm) {
   if (co_.optimize_ir) {
+    internalizeRuntimeFunctions();
+
     llvm::TargetLibraryInfoImpl target_info(llvm::Triple(module_->getTargetTriple()));
 
     llvm::ModuleAnalysisManager module_analysis_mgr;
@@ -218,10 +229,18 @@ void LLVMJITModule::optimizeIR(llvm::TargetMachine* tm) {
                                       cgscc_analysis_mgr,
                                       module_analysis_mgr);
 
-    llvm::ModulePassManager module_pass_mgr;
-
-    module_pass_mgr.addPass(
+    llvm::ModulePassManager inline_pass_mgr;
+    inline_pass_mgr.addPass(
         llvm::AlwaysInlinerPass(false));  // Inline all functions labeled as always_inline
+    inline_pass_mgr.run(*module_, module_analysis_mgr);
+    if (co_.report_inlining) {
+      called_after_inlining_ = collectCalledFunctions();
+    }
+
+    llvm::ModulePassManager module_pass_mgr;
+    // Drop runtime functions and globals which are fully inlined or never referenced.
+    module_pass_mgr.addPass(llvm::GlobalDCEPass());
+    module_pass_mgr.addPass(llvm::StripDeadPrototypesPass());
 
     llvm::FunctionPassManager function_pass_mgr1;
     function_pass_mgr1.addPass(llvm::SimplifyCFGPass());
@@ -257,6 +276,87 @@ void* LLVMJITModule::getFunctionPtrImpl(LLVMJITFunction& function) {
   return nullptr;
 }
 
+void LLVMJITModule::internalizeRuntimeFunctions() {
+  // Definitions cloned from the runtime module are private to this module, only
+  // functions created by JITFunctionBuilder need to be exported.
+  for (auto& func : module_->functions()) {
+    if (func.isDeclaration() || llvm::is_contained(owned_functions_, &func)) {
+      continue;
+    }
+    func.setLinkage(llvm::GlobalValue::InternalLinkage);
+  }
+  for (auto& global : module_->globals()) {
+    if (!global.isDeclaration()) {
+      global.setLinkage(llvm::GlobalValue::InternalLinkage);
+    }
+  }
+}
+
+llvm::StringSet<> LLVMJITModule::collectCalledFunctions() const {
+  llvm::StringSet<> called;
+  for (auto& func : module_->functions()) {
+    for (auto& inst : llvm::instructions(func)) {
+      if (auto call = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+        if (auto callee = call->getCalledFunction(); callee && !callee->isIntrinsic()) {
+          called.insert(callee->getName());
+        }
+      }
+    }
+  }
+  return called;
+}
+
+int64_t LLVMJITModule::countVectorizedLoops() const {
+  int64_t num = 0;
+  for (auto func : owned_functions_) {
+    for (auto& block : *func) {
+      auto terminator = block.getTerminator();
+      auto loop_id =
+          terminator ? terminator->getMetadata(llvm::LLVMContext::MD_loop) : nullptr;
+      if (!loop_id) {
+        continue;
+      }
+      for (auto& operand : loop_id->operands()) {
+        auto node = llvm::dyn_cast_or_null<llvm::MDNode>(operand.get());
+        if (node && node->getNumOperands() > 0) {
+          auto name = llvm::dyn_cast<llvm::MDString>(node->getOperand(0));
+          num += name && name->getString() == "llvm.loop.isvectorized";
+        }
+      }
+    }
+  }
+  return num;
+}
+
+void LLVMJITModule::buildInliningReport() {
+  auto called = collectCalledFunctions();
+  // Without IR optimization nothing is inlined or removed.
+  auto& called_after_inlining = co_.optimize_ir ? called_after_inlining_ : called;
+
+  inlining_report_ = InliningReport{};
+  for (auto& entry : referenced_runtime_functions_) {
+    auto name = entry.getKey().str();
+    if (called.contains(entry.getKey())) {
+      inlining_report_.called.emplace_back(std::move(name));
+    } else if (called_after_inlining.contains(entry.getKey())) {
+      inlining_report_.removed.emplace_back(std::move(name));
+    } else {
+      inlining_report_.inlined.emplace_back(std::move(name));
+    }
+  }
+  for (auto list : {&inlining_report_.inlined,
+                    &inlining_report_.removed,
+                    &inlining_report_.called}) {
+    std::sort(list->begin(), list->end());
+  }
+
+  LOG(INFO) << "Module " << getName() << " inlined runtime functions: ["
+            << ::join(inlining_report_.inlined, ", ")
+            << "], removed runtime function calls: ["
+            << ::join(inlining_report_.removed, ", ") << "], called runtime functions: ["
+            << ::join(inlining_report_.called, ", ") << "]";
+}
+
 void LLVMJITModule::copyRuntimeModule() {
   module_ = llvm::CloneModule(*runtime_module_, vmap_, [](const llvm::GlobalValue* gv) {
     auto func = llvm::dyn_cast<llvm::Function>(gv);
@@ -21,6 +21,7 @@
 #ifndef JITLIB_LLVMJIT_LLVMJITMODULE_H
 #define JITLIB_LLVMJIT_LLVMJITMODULE_H
 
+#include <llvm/ADT/StringSet.h>
 #include <llvm/IR/LegacyPassManager.h>
 
 #include <llvm/IR/LLVMContext.h>
@@ -33,6 +34,15 @@
 
 namespace cider::jitlib {
 
+// Runtime functions referenced by a module, split by what became of their call sites
+// during IR optimization: inlined by the always inliner, removed as dead code after
+// inlining (e.g. in a branch folded away), or still called.
+struct InliningReport {
+  std::vector<std::string> inlined;
+  std::vector<std::string> removed;
+  std::vector<std::string> called;
+};
+
 class LLVMJITModule final : public JITModule {
  public:
   friend LLVMJITEngineBuilder;
@@ -51,10 +61,21 @@ class LLVMJITModule final : public JITModule {
 
   void finish(const std::string& main_func = "") override;
 
+  // Only available after finish() with CompilationOptions::report_inlining enabled.
+  const InliningReport& getInliningReport() const { return inlining_report_; }
+
+  // Number of loops in functions of this module processed by the loop vectorizer, their
+  // scalar remainder loops included. Only available after finish().
+  int64_t getVectorizedLoopNum() const { return vectorized_loop_num_; }
+
  protected:
   void* getFunctionPtrImpl(LLVMJITFunction& function);
   void optimizeIR(llvm::TargetMachine* tm);
   void copyRuntimeModule();
+  void internalizeRuntimeFunctions();
+  void buildInliningReport();
+  llvm::StringSet<> collectCalledFunctions() const;
+  int64_t countVectorizedLoops() const;
   JITFunctionPointer createJITFunction(const JITFunctionDescriptor& descriptor) override;
 
  private:
@@ -65,6 +86,11 @@ class LLVMJITModule final : public JITModule {
   std::unique_ptr<llvm::Module> runtime_module_;
   CompilationOptions co_;
   llvm::SmallVector<llvm::Function*, 1> owned_functions_;
+  llvm::StringSet<> referenced_runtime_functions_;
+  // Functions still called right after the always inliner, for the inlining report.
+  llvm::StringSet<> called_after_inlining_;
+  InliningReport inlining_report_;
+  int64_t vectorized_loop_num_{0};
 };
 };  // namespace cider::jitlib
 
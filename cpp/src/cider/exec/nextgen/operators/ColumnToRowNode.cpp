@@ -29,11 +29,15 @@
 
 namespace cider::exec::nextgen::operators {
 using namespace cider::jitlib;
+using context::batch_runtime_utils::ArrowArrayEncoding;
 
 class ColumnReader {
  public:
   ColumnReader(context::CodegenContext& ctx, ExprPtr& expr, JITValuePointer& index)
-      : context_(ctx), expr_(expr), index_(index) {}
+      : context_(ctx)
+      , expr_(expr)
+      , index_(index)
+      , value_index_(nullptr) {}
 
   void read(bool for_null) {
     switch (expr_->get_type_info().get_type()) {
@@ -77,11 +81,12 @@ class ColumnReader {
       return;
     }
 
+    resolveIndices(func, batch);
     // offset buffer
     auto offset_pointer =
         varsize_values.getLength()->castPointerSubType(JITTypeTag::INT32);
-    auto len = offset_pointer[index_ + 1] - offset_pointer[index_];
-    auto cur_offset = offset_pointer[index_];
+    auto len = offset_pointer[value_index_ + 1] - offset_pointer[value_index_];
+    auto cur_offset = offset_pointer[value_index_];
     // data buffer
     auto value_pointer = varsize_values.getValue()->castPointerSubType(JITTypeTag::INT8);
     auto row_data = value_pointer + cur_offset;  // still char*
@@ -120,6 +125,7 @@ class ColumnReader {
       return;
     }
 
+    resolveIndices(func, batch);
     auto row_data = getFixSizeRowData(func, fixsize_values);
     if ((FLAGS_null_separate && !for_null) || expr_->get_type_info().get_notnull()) {
       expr_->set_expr_value(func.createLiteral(JITTypeTag::BOOL, false), row_data);
@@ -140,6 +146,39 @@ class ColumnReader {
     }
   }
 
+  // Maps the row to the index of its value, which differs from the row index for
+  // encoded columns (see batch_runtime_utils::ArrowArrayEncoding). The encoding is
+  // loop-invariant, so branches on it are unswitched out of the row loop and loads of
+  // constant values are hoisted.
+  void resolveIndices(JITFunction& func, JITValuePointer& batch) {
+    auto encoding = func.createLocalJITValue(
+        [&batch]() { return context::codegen_utils::getArrowArrayEncoding(batch); });
+    auto value_indices = func.createLocalJITValue([this, &func, &batch]() {
+      auto input_array = func.getArgument(1);
+      auto len = context::codegen_utils::getArrowArrayLength(input_array);
+      return context_.registerValueIndices(batch, len);
+    });
+
+    value_index_.replace(func.createVariable(JITTypeTag::INT64, "value_index", 0l));
+    value_index_ = *index_;
+    func.createIfBuilder()
+        ->condition([&encoding]() {
+          return encoding == static_cast<int32_t>(ArrowArrayEncoding::kConstant);
+        })
+        ->ifTrue([&]() { value_index_ = *func.createLiteral(JITTypeTag::INT64, 0l); })
+        ->build();
+    func.createIfBuilder()
+        ->condition([&encoding]() {
+          return encoding == static_cast<int32_t>(ArrowArrayEncoding::kDictionary) ||
+                 encoding == static_cast<int32_t>(ArrowArrayEncoding::kRunEnd);
+        })
+        ->ifTrue([&]() {
+          value_index_ =
+              *value_indices[*index_]->castJITValuePrimitiveType(JITTypeTag::INT64);
+        })
+        ->build();
+  }
+
   JITValuePointer getFixSizeRowData(JITFunction& func,
                                     utils::FixSizeJITExprValue& fixsize_val) {
     if (expr_->get_type_info().get_type() == kBOOLEAN) {
@@ -147,13 +186,13 @@ class ColumnReader {
           "check_bit_vector_set",
           JITFunctionEmitDescriptor{
               .ret_type = JITTypeTag::BOOL,
-              .params_vector = {{fixsize_val.getValue().get(), index_.get()}}});
+              .params_vector = {{fixsize_val.getValue().get(), value_index_.get()}}});
       return row_data;
     } else {
       JITTypeTag tag = utils::getJITTypeTag(expr_->get_type_info().get_type());
       // data buffer decoder
       auto data_pointer = fixsize_val.getValue()->castPointerSubType(tag);
-      auto row_data = data_pointer[index_];
+      auto row_data = data_pointer[value_index_];
       return row_data;
     }
   }
@@ -162,6 +201,7 @@ class ColumnReader {
   context::CodegenContext& context_;
   ExprPtr& expr_;
   JITValuePointer& index_;
+  JITValuePointer value_index_;
 };
 
 TranslatorPtr ColumnToRowNode::toTranslator(const TranslatorPtr& succ) {
@@ -196,31 +236,125 @@ void ColumnToRowTranslator::codegenImpl(SuccessorEmitter successor_wrapper,
   auto len = func->createLocalJITValue([&input_array]() {
     return context::codegen_utils::getArrowArrayLength(input_array);
   });
+  auto c2r_node = static_cast<ColumnToRowNode*>(node_.get());
+  bool resumable = !for_null_ && c2r_node->isResumable() &&
+                   context.getCodegenOptions().max_output_rows > 0;
   if (!for_null_) {
-    static_cast<ColumnToRowNode*>(node_.get())->setColumnRowNum(len);
+    // Output buffers are still sized by input length when rows are selected. Bounded
+    // output of joins never exceeds max_output_rows whatever the fan-out is.
+    if (resumable && c2r_node->hasFanOut()) {
+      auto max_rows = func->createLiteral(JITTypeTag::INT64,
+                                          context.getCodegenOptions().max_output_rows);
+      c2r_node->setColumnRowNum(max_rows);
+    } else {
+      c2r_node->setColumnRowNum(len);
+    }
+    c2r_node->setRowIndex(index);
+  }
+
+  // Only visit rows selected by a preceding vectorized filter.
+  auto& selection = c2r_node->getSelection().first;
+  if (!for_null_ && context.hasFilterSelection()) {
+    auto&& [selection_vector, selected_num] = context.takeFilterSelection();
+    selection.replace(selection_vector);
+    c2r_node->getSelection().second.replace(selected_num);
+    len.replace(selected_num);
   }
   auto idx_upper = func->createVariable(JITTypeTag::INT64, "idx_upper", len);
+  if (selection.get()) {
+    // Variables are initialized in the entry block, load the selected row num here.
+    idx_upper = *len;
+  }
   if (for_null_) {
     // pack 8 bit
     idx_upper = len / 8 + 1;
   }
 
-  func->createLoopBuilder()
-      ->condition([&index, &idx_upper]() { return index < idx_upper; })
-      ->loop([&](LoopBuilder*) {
-        for (auto& input : inputs) {
-          ColumnReader(context, input, index).read(for_null_);
-        }
-        successor_wrapper(successor, context);
-      })
-      ->update([&index]() { index = index + 1l; })
-      ->build();
+  // Null counters of nullable inputs, rows are counted once per batch. Selected rows
+  // have already been counted by the filter.
+  std::vector<std::pair<ExprPtr, int64_t>> null_counters;
+  if (!for_null_ && !FLAGS_null_separate && !selection.get() &&
+      context.getCodegenOptions().enable_runtime_profile) {
+    auto rows_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kInputRows, "input");
+    context.codegenProfileCounterAdd(rows_counter, *len);
+    for (auto& input : inputs) {
+      if (!input->get_type_info().get_notnull()) {
+        null_counters.emplace_back(
+            input,
+            context.registerProfileCounter(context::ProfileCounterKind::kColumnNull,
+                                           input->toString()));
+      }
+    }
+  }
+
+  auto loop_index =
+      selection.get() ? func->createVariable(JITTypeTag::INT64, "selection_index", 0)
+                      : index;
+  auto output_full = JITValuePointer(nullptr);
+  if (resumable) {
+    output_full.replace(context.codegenResumableLoop(loop_index, idx_upper));
+  }
+  // Loops over [loop_index, upper) without polling for interruption.
+  auto build_row_loop = [&](JITValuePointer& upper) {
+    func->createLoopBuilder()
+        ->condition([&loop_index, &upper, &output_full]() {
+          if (output_full.get()) {
+            return loop_index < upper && !output_full;
+          }
+          return loop_index < upper;
+        })
+        ->loop([&](LoopBuilder*) {
+          if (selection.get()) {
+            index = *selection[*loop_index]->castJITValuePrimitiveType(JITTypeTag::INT64);
+          }
+          for (auto& input : inputs) {
+            ColumnReader(context, input, index).read(for_null_);
+          }
+          for (auto& [input, counter] : null_counters) {
+            utils::JITExprValueAdaptor values(input->get_expr_value());
+            context.codegenProfileCounterAdd(counter, *values.getNull());
+          }
+          successor_wrapper(successor, context);
+        })
+        ->update([&loop_index]() { loop_index = loop_index + 1l; })
+        ->build();
+  };
+
+  int64_t interval = context.getCodegenOptions().interrupt_check_interval;
+  if (interval <= 0) {
+    build_row_loop(idx_upper);
+  } else {
+    // Strip-mined, rows are processed in chunks of interval rows and interruption is
+    // polled between chunks (short loops never poll). The row loop keeps a single exit
+    // and no opaque call, so it can still be vectorized.
+    auto chunk_upper = func->createVariable(JITTypeTag::INT64, "chunk_upper", 0l);
+    func->createLoopBuilder()
+        ->condition([&loop_index, &idx_upper, &output_full]() {
+          if (output_full.get()) {
+            return loop_index < idx_upper && !output_full;
+          }
+          return loop_index < idx_upper;
+        })
+        ->loop([&](LoopBuilder*) {
+          chunk_upper = loop_index + interval;
+          func->createIfBuilder()
+              ->condition([&]() { return chunk_upper > idx_upper; })
+              ->ifTrue([&]() { chunk_upper = *idx_upper; })
+              ->build();
+          build_row_loop(chunk_upper);
+          func->createIfBuilder()
+              ->condition([&]() { return loop_index < idx_upper; })
+              ->ifTrue([&]() { context.codegenInterruptCheck(); })
+              ->build();
+        })
+        ->build();
+  }
 
   if (for_null_) {
     return;
   }
   // Execute defer build functions.
-  auto c2r_node = static_cast<ColumnToRowNode*>(node_.get());
   for (auto& defer_func : c2r_node->getDeferFunctions()) {
     defer_func();
   }
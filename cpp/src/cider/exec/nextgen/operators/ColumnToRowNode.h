@@ -42,6 +42,32 @@ class ColumnToRowNode : public OpNode {
     column_row_num_.replace(row_num);
   }
 
+  // Index of the input row being processed, valid inside the loop body.
+  jitlib::JITValuePointer& getRowIndex() { return row_index_; }
+
+  void setRowIndex(jitlib::JITValuePointer& index) {
+    CHECK(row_index_.get() == nullptr);
+    row_index_.replace(index);
+  }
+
+  // Selection vector and selected row num if the loop only visits rows selected by a
+  // vectorized filter, null otherwise.
+  std::pair<jitlib::JITValuePointer, jitlib::JITValuePointer>& getSelection() {
+    return selection_;
+  }
+
+  // Bounds the rows written by the loop with CodegenOptions::max_output_rows, the loop
+  // then yields once the output batch is full and resumes on the next run. fan_out
+  // tells whether an input row may produce more than one output row.
+  void setResumable(bool fan_out) {
+    resumable_ = true;
+    fan_out_ = fan_out;
+  }
+
+  bool isResumable() const { return resumable_; }
+
+  bool hasFanOut() const { return fan_out_; }
+
   using DeferFunc = void (*)(void*);
 
   template <typename FuncT>
@@ -53,7 +79,11 @@ class ColumnToRowNode : public OpNode {
 
  private:
   jitlib::JITValuePointer column_row_num_;
+  jitlib::JITValuePointer row_index_;
+  std::pair<jitlib::JITValuePointer, jitlib::JITValuePointer> selection_;
   std::vector<std::function<void()>> defer_func_list_;
+  bool resumable_{false};
+  bool fan_out_{false};
 };
 
 class ColumnToRowTranslator : public Translator {
@@ -20,7 +20,10 @@
  */
 #include "exec/nextgen/operators/FilterNode.h"
 
+#include <algorithm>
+
 #include "exec/nextgen/jitlib/JITLib.h"
+#include "type/plan/Analyzer.h"
 
 namespace cider::exec::nextgen::operators {
 using namespace jitlib;
@@ -33,20 +36,173 @@ void FilterTranslator::consume(context::CodegenContext& context) {
   codegen(context);
 }
 
+namespace {
+// Conjuncts cheaper than this are evaluated together without branches.
+constexpr double kExpensiveConjunctCost = 8;
+
+// Rough per-row evaluation cost of an expression tree, relative to a comparison.
+double estimateCost(const ExprPtr& expr) {
+  if (!expr || dynamic_cast<Analyzer::ColumnVar*>(expr.get()) ||
+      dynamic_cast<Analyzer::Constant*>(expr.get())) {
+    return 0;
+  }
+
+  double cost = 1;
+  if (dynamic_cast<Analyzer::RegexpExpr*>(expr.get())) {
+    cost = 32;
+  } else if (dynamic_cast<Analyzer::LikeExpr*>(expr.get())) {
+    cost = 16;
+  } else if (dynamic_cast<Analyzer::StringOper*>(expr.get()) ||
+             dynamic_cast<Analyzer::FunctionOper*>(expr.get())) {
+    cost = 8;
+  } else if (dynamic_cast<Analyzer::InValues*>(expr.get()) ||
+             dynamic_cast<Analyzer::CaseExpr*>(expr.get())) {
+    cost = 4;
+  } else if (auto bin_oper = dynamic_cast<Analyzer::BinOper*>(expr.get());
+             bin_oper && bin_oper->get_left_operand()->get_type_info().is_string()) {
+    cost = 4;
+  }
+
+  for (auto child : expr->get_children_reference()) {
+    if (child) {
+      cost += estimateCost(*child);
+    }
+  }
+  return cost;
+}
+
+// Selectivity guess used when there is no runtime profile of the conjunct.
+double estimateSelectivity(const ExprPtr& expr) {
+  if (auto bin_oper = dynamic_cast<Analyzer::BinOper*>(expr.get())) {
+    switch (bin_oper->get_optype()) {
+      case kEQ:
+      case kBW_EQ:
+        return 0.1;
+      case kNE:
+      case kBW_NE:
+        return 0.9;
+      default:
+        return 0.5;
+    }
+  }
+  if (dynamic_cast<Analyzer::LikeExpr*>(expr.get()) ||
+      dynamic_cast<Analyzer::RegexpExpr*>(expr.get()) ||
+      dynamic_cast<Analyzer::InValues*>(expr.get())) {
+    return 0.25;
+  }
+  return 0.5;
+}
+
+// Rows pass a filter only if every conjunct is true, so nested ANDs can be split even
+// for nullable operands.
+void flattenConjuncts(const ExprPtr& expr, ExprPtrVector& conjuncts) {
+  auto bin_oper = dynamic_cast<Analyzer::BinOper*>(expr.get());
+  if (bin_oper && bin_oper->get_optype() == kAND) {
+    flattenConjuncts(bin_oper->get_own_left_operand(), conjuncts);
+    flattenConjuncts(bin_oper->get_own_right_operand(), conjuncts);
+  } else {
+    conjuncts.push_back(expr);
+  }
+}
+}  // namespace
+
+FilterTranslator::ConjunctGroups FilterTranslator::buildConjunctGroups(
+    context::CodegenContext& context,
+    const std::string& filter_name) {
+  auto codegen_options = context.getCodegenOptions();
+  auto&& [expr_type, exprs] = node_->getOutputExprs();
+
+  ExprPtrVector flattened;
+  for (const auto& expr : exprs) {
+    flattenConjuncts(expr, flattened);
+  }
+
+  std::vector<Conjunct> conjuncts;
+  for (size_t i = 0; i < flattened.size(); ++i) {
+    auto& expr = flattened[i];
+    auto name = filter_name + ".conjunct_" + std::to_string(i);
+    Conjunct conjunct{expr, estimateCost(expr), estimateSelectivity(expr)};
+    if (codegen_options.conjunct_selectivity) {
+      auto iter = codegen_options.conjunct_selectivity->find(name);
+      if (iter != codegen_options.conjunct_selectivity->end()) {
+        conjunct.selectivity = iter->second;
+      }
+    }
+    if (codegen_options.enable_runtime_profile) {
+      conjunct.input_counter = context.registerProfileCounter(
+          context::ProfileCounterKind::kConjunctInput, name);
+      conjunct.output_counter = context.registerProfileCounter(
+          context::ProfileCounterKind::kConjunctOutput, name);
+    }
+    conjuncts.emplace_back(std::move(conjunct));
+  }
+
+  auto rank = [](const Conjunct& conjunct) {
+    return conjunct.cost / std::max(1 - conjunct.selectivity, 1e-6);
+  };
+  std::stable_sort(conjuncts.begin(),
+                   conjuncts.end(),
+                   [&rank](const Conjunct& a, const Conjunct& b) {
+                     return rank(a) < rank(b);
+                   });
+
+  ConjunctGroups groups;
+  for (auto& conjunct : conjuncts) {
+    if (groups.empty() || conjunct.cost >= kExpensiveConjunctCost ||
+        groups.back().back().cost >= kExpensiveConjunctCost) {
+      groups.emplace_back();
+    }
+    groups.back().emplace_back(std::move(conjunct));
+  }
+  return groups;
+}
+
 void FilterTranslator::codegen(context::CodegenContext& context) {
+  int64_t output_counter = -1;
+  auto name = context.registerFilter();
+  if (context.getCodegenOptions().enable_runtime_profile) {
+    auto input_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kFilterInput, name);
+    output_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kFilterOutput, name);
+    context.codegenProfileCounterAdd(input_counter, 1);
+  }
+
+  auto groups = buildConjunctGroups(context, name);
+  codegenConjunctGroups(context, groups, 0, output_counter);
+}
+
+void FilterTranslator::codegenConjunctGroups(context::CodegenContext& context,
+                                             ConjunctGroups& groups,
+                                             size_t group_index,
+                                             int64_t output_counter) {
+  if (group_index == groups.size()) {
+    if (output_counter >= 0) {
+      context.codegenProfileCounterAdd(output_counter, 1);
+    }
+    successor_->consume(context);
+    return;
+  }
+
   auto func = context.getJITFunction();
   func->createIfBuilder()
       ->condition([&]() {
         auto bool_init = func->createVariable(JITTypeTag::BOOL, "bool_init");
         *bool_init = func->createLiteral(JITTypeTag::BOOL, true);
-        auto&& [expr_type, exprs] = node_->getOutputExprs();
-        for (const auto& expr : exprs) {
-          utils::FixSizeJITExprValue cond(expr->codegen(context));
-          bool_init = bool_init && cond.getValue() && !cond.getNull();
+        for (auto& conjunct : groups[group_index]) {
+          utils::FixSizeJITExprValue cond(conjunct.expr->codegen(context));
+          auto passed = cond.getValue() && !cond.getNull();
+          if (conjunct.input_counter >= 0) {
+            context.codegenProfileCounterAdd(conjunct.input_counter, 1);
+            context.codegenProfileCounterAdd(conjunct.output_counter, *passed);
+          }
+          bool_init = bool_init && passed;
         }
         return bool_init;
       })
-      ->ifTrue([&]() { successor_->consume(context); })
+      ->ifTrue([&]() {
+        codegenConjunctGroups(context, groups, group_index + 1, output_counter);
+      })
       ->build();
 }
 }  // namespace cider::exec::nextgen::operators
@@ -43,7 +43,29 @@ class FilterTranslator : public Translator {
   void consume(context::CodegenContext& context) override;
 
  private:
+  // A filter condition, conjuncts are evaluated in ascending order of
+  // cost / (1 - selectivity).
+  struct Conjunct {
+    ExprPtr expr;
+    double cost;
+    double selectivity;
+    int64_t input_counter{-1};
+    int64_t output_counter{-1};
+  };
+  // Conjuncts combined with branchless AND, groups are short-circuited one by one.
+  using ConjunctGroups = std::vector<std::vector<Conjunct>>;
+
+  // Conjuncts are named "<filter name>.conjunct_<i>" after their position in the
+  // filter condition, which is the key of their measured selectivity.
+  ConjunctGroups buildConjunctGroups(context::CodegenContext& context,
+                                     const std::string& filter_name);
+
   void codegen(context::CodegenContext& context);
+
+  void codegenConjunctGroups(context::CodegenContext& context,
+                             ConjunctGroups& groups,
+                             size_t group_index,
+                             int64_t output_counter);
 };
 
 }  // namespace cider::exec::nextgen::operators
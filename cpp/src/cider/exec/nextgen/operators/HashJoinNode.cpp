@@ -198,12 +198,33 @@ void HashJoinTranslator::codegen(context::CodegenContext& context) {
           .params_vector = {
               hashtable.get(), key_value.get(), key_null.get(), join_res_buffer.get()}});
 
+  if (context.getCodegenOptions().enable_runtime_profile) {
+    auto name = "hash_join_" + std::to_string(context.getProfileCounterNum(
+                                   context::ProfileCounterKind::kJoinProbe));
+    auto probe_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kJoinProbe, name);
+    auto match_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kJoinMatch, name);
+    context.codegenProfileCounterAdd(probe_counter, 1);
+    context.codegenProfileCounterAdd(match_counter, *join_res_len);
+  }
+
   auto build_table_map = dynamic_cast<HashJoinNode*>(node_.get())->getBuildTableMap();
   auto row_index = func->createVariable(JITTypeTag::INT64, "row_index", 0l);
   row_index = func->createLiteral(JITTypeTag::INT64, 0l);
+  auto output_full = JITValuePointer(nullptr);
+  if (context.isResumableLoop()) {
+    output_full.replace(context.codegenResumableMatchLoop(row_index, join_res_len));
+  }
   func->createLoopBuilder()
-      ->condition([&row_index, &join_res_len]() { return row_index < join_res_len; })
+      ->condition([&row_index, &join_res_len, &output_full]() {
+        if (output_full.get()) {
+          return row_index < join_res_len && !output_full;
+        }
+        return row_index < join_res_len;
+      })
       ->loop([&](LoopBuilder*) {
+        context.codegenInterruptCheck(row_index);
         auto res_array = func->emitRuntimeFunctionCall(
             "extract_join_res_array",
             JITFunctionEmitDescriptor{
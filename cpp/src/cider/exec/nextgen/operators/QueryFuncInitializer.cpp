@@ -56,9 +56,16 @@ void QueryFuncInitializerTranslator::codegen(context::CodegenContext& context) {
     int64_t buffer_num = utils::getBufferNum(col_var_expr->get_type_info().get_type());
     utils::JITExprValue buffer_values(buffer_num, JITExprValueType::BATCH);
 
+    // Validity is loaded per row, the other buffers of encoded columns are loaded from
+    // their values and rows are mapped to values by ColumnToRowNode.
     for (int64_t i = 0; i < buffer_num; ++i) {
-      auto buffer = func->createLocalJITValue([&child_array, i]() {
-        return context::codegen_utils::getArrowArrayBuffer(child_array, i);
+      auto buffer = func->createLocalJITValue([&context, &func, &child_array, i]() {
+        if (i == 0) {
+          auto input_array = func->getArgument(1);
+          auto len = context::codegen_utils::getArrowArrayLength(input_array);
+          return context.registerRowValidity(child_array, len);
+        }
+        return context::codegen_utils::getArrowArrayValuesBuffer(child_array, i);
       });
       buffer_values.append(buffer);
     }
@@ -86,7 +93,8 @@ void QueryFuncInitializerTranslator::codegen(context::CodegenContext& context) {
                     return output_types;
                   }()),
       "output",
-      true);
+      true,
+      context.getCodegenOptions().string_view_output);
   context.appendArrowArrayValues(output_arrow_array,
                                  utils::JITExprValue(1, JITExprValueType::BATCH));
 
@@ -24,6 +24,7 @@
 #include "cider/CiderOptions.h"
 #include "exec/nextgen/context/CodegenContext.h"
 #include "exec/nextgen/jitlib/JITLib.h"
+#include "exec/nextgen/operators/ProjectNode.h"
 #include "exec/nextgen/utils/JITExprValue.h"
 
 namespace cider::exec::nextgen::operators {
@@ -81,6 +82,11 @@ class ColumnWriter {
       return;
     }
 
+    if (context_.getCodegenOptions().string_view_output) {
+      writeStringViewCol(values);
+      return;
+    }
+
     // Allocate buffer
     // offset, need array_len + 1 element.
     auto raw_length_buffer = context_.getJITFunction()->createLocalJITValue([this]() {
@@ -127,6 +133,32 @@ class ColumnWriter {
         setNullBuffer(values.getNull(), for_null), raw_length_buffer, raw_data_buffer);
   }
 
+  void writeStringViewCol(utils::VarSizeJITExprValue& values) {
+    // 16 bytes view per row.
+    auto views_buffer = context_.getJITFunction()->createLocalJITValue([this]() {
+      context_.getJITFunction()->emitRuntimeFunctionCall(
+          "init_string_view_buffers",
+          JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                    .params_vector = {arrow_array_.get()}});
+      auto bytes = arrow_array_len_ * 16;
+      return allocateRawDataBuffer(1, bytes);
+    });
+
+    context_.getJITFunction()->emitRuntimeFunctionCall(
+        "write_string_view",
+        JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                  .params_vector = {arrow_array_.get(),
+                                                    views_buffer.get(),
+                                                    index_.get(),
+                                                    values.getValue().get(),
+                                                    values.getLength().get(),
+                                                    values.getNull().get()}});
+
+    // Save JITValues of output buffers to corresponding exprs.
+    buffers_.clear();
+    buffers_.append(setNullBuffer(values.getNull(), false), views_buffer);
+  }
+
   void writeFixSizedTypeCol(bool for_null) {
     // Get values need to write
     utils::FixSizeJITExprValue values(expr_->get_expr_value());
@@ -264,6 +296,93 @@ void RowToColumnTranslator::consumeNull(context::CodegenContext& context) {
   });
 }
 
+namespace {
+// Returns the input ColumnVar if expr outputs an input column unmodified. Varchar input
+// columns can't be shared by Utf8View output (string_view).
+Analyzer::ColumnVar* getPassThroughColumn(const ExprPtr& expr, bool string_view) {
+  if (!dynamic_cast<Analyzer::OutputColumnVar*>(expr.get())) {
+    return nullptr;
+  }
+  switch (expr->get_type_info().get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+    case kSMALLINT:
+    case kINT:
+    case kBIGINT:
+    case kFLOAT:
+    case kDOUBLE:
+    case kDATE:
+    case kTIMESTAMP:
+    case kTIME:
+      break;
+    case kVARCHAR:
+    case kCHAR:
+    case kTEXT:
+      if (string_view) {
+        return nullptr;
+      }
+      break;
+    default:
+      return nullptr;
+  }
+  auto col_var = dynamic_cast<Analyzer::ColumnVar*>(
+      expr->get_children_reference().front()->get());
+  return col_var && col_var->getLocalIndex() ? col_var : nullptr;
+}
+
+void codegenPassThrough(
+    context::CodegenContext& context,
+    const ExprPtr& expr,
+    Analyzer::ColumnVar* col_var,
+    std::pair<JITValuePointer, JITValuePointer>& selection,
+    JITValuePointer& row_num) {
+  auto func = context.getJITFunction();
+  auto& output_array = context.getArrowArrayValues(expr->getLocalIndex()).first;
+  auto& input_array = context.getArrowArrayValues(col_var->getLocalIndex()).first;
+
+  auto type = expr->get_type_info().get_type();
+  int64_t value_bytes = 0;
+  if (type != kBOOLEAN && !expr->get_type_info().is_string()) {
+    value_bytes = utils::getTypeBytes(type);
+  }
+  auto jit_value_bytes = func->createLiteral(JITTypeTag::INT64, value_bytes);
+
+  if (selection.first.get()) {
+    func->emitRuntimeFunctionCall(
+        "gather_arrow_array",
+        JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                  .params_vector = {output_array.get(),
+                                                    input_array.get(),
+                                                    jit_value_bytes.get(),
+                                                    selection.first.get(),
+                                                    selection.second.get()}});
+  } else {
+    func->emitRuntimeFunctionCall(
+        "pass_through_arrow_array",
+        JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                  .params_vector = {func->getArgument(0).get(),
+                                                    output_array.get(),
+                                                    input_array.get(),
+                                                    jit_value_bytes.get(),
+                                                    row_num.get()}});
+  }
+}
+
+// Whether every row visited by the C2R loop reaches the R2C exactly once.
+bool isRowPreserving(const OpNode* node, const ColumnToRowNode* c2r) {
+  for (auto input = node->getInputOpNode().get(); input;
+       input = input->getInputOpNode().get()) {
+    if (input == c2r) {
+      return true;
+    }
+    if (!dynamic_cast<const ProjectNode*>(input)) {
+      return false;
+    }
+  }
+  return false;
+}
+}  // namespace
+
 void RowToColumnTranslator::codegenImpl(SuccessorEmitter successor_wrapper,
                                         context::CodegenContext& context,
                                         void* successor) {
@@ -277,13 +396,28 @@ void RowToColumnTranslator::codegenImpl(SuccessorEmitter successor_wrapper,
   auto prev_c2r_node = static_cast<RowToColumnNode*>(node_.get())->getColumnToRowNode();
   auto input_array_len = prev_c2r_node->getColumnRowNum();
 
+  // Unmodified input columns are exported after the loop as a whole, by sharing input
+  // buffers or gathering selected rows, instead of being written row by row.
+  std::vector<std::pair<ExprPtr, Analyzer::ColumnVar*>> pass_through_exprs;
+  // Bounded output only exports a part of input rows per run.
+  bool row_preserving =
+      !prev_c2r_node->isResumable() && isRowPreserving(node_.get(), prev_c2r_node);
   for (int64_t i = 0; i < exprs.size(); ++i) {
     ExprPtr& expr = exprs[i];
+    bool string_view = context.getCodegenOptions().string_view_output;
+    if (auto col_var =
+            row_preserving ? getPassThroughColumn(expr, string_view) : nullptr) {
+      pass_through_exprs.emplace_back(expr, col_var);
+      continue;
+    }
     ColumnWriter writer(context, expr, output_index, input_array_len);
     writer.write(for_null_);
   }
   // Update index
   output_index = output_index + 1;
+  if (!for_null_ && prev_c2r_node->isResumable() && context.isResumableLoop()) {
+    context.codegenOutputYield(output_index);
+  }
 
   successor_wrapper(successor, context);
 
@@ -292,7 +426,18 @@ void RowToColumnTranslator::codegenImpl(SuccessorEmitter successor_wrapper,
   }
 
   // Execute length field updating build function after C2R loop finished.
-  prev_c2r_node->registerDeferFunc([output_index, &output_exprs, &context]() mutable {
+  prev_c2r_node->registerDeferFunc([output_index,
+                                    pass_through_exprs,
+                                    prev_c2r_node,
+                                    &output_exprs,
+                                    &context]() mutable {
+    for (auto& [expr, col_var] : pass_through_exprs) {
+      codegenPassThrough(context,
+                         expr,
+                         col_var,
+                         prev_c2r_node->getSelection(),
+                         prev_c2r_node->getColumnRowNum());
+    }
     for (auto& expr : output_exprs) {
       size_t local_offset = expr->getLocalIndex();
       CHECK_NE(local_offset, 0);
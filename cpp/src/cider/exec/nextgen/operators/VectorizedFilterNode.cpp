@@ -0,0 +1,89 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "exec/nextgen/operators/VectorizedFilterNode.h"
+
+#include "exec/nextgen/context/CodegenContext.h"
+#include "exec/nextgen/operators/ColumnToRowNode.h"
+#include "exec/nextgen/utils/ExprUtils.h"
+#include "exec/nextgen/utils/JITExprValue.h"
+
+namespace cider::exec::nextgen::operators {
+using namespace jitlib;
+
+TranslatorPtr VectorizedFilterNode::toTranslator(const TranslatorPtr& succ) {
+  return createOpTranslator<VectorizedFilterTranslator>(shared_from_this(), succ);
+}
+
+void VectorizedFilterTranslator::consume(context::CodegenContext& context) {
+  codegen(context, [this](context::CodegenContext& context) {
+    if (successor_) {
+      successor_->consume(context);
+    }
+  });
+}
+
+void VectorizedFilterTranslator::codegenImpl(SuccessorEmitter successor_wrapper,
+                                             context::CodegenContext& context,
+                                             void* successor) {
+  auto func = context.getJITFunction();
+  ExprPtrVector& exprs = node_->getOutputExprs().second;
+
+  auto input_array = func->getArgument(1);
+  auto len = func->createLocalJITValue([&input_array]() {
+    return context::codegen_utils::getArrowArrayLength(input_array);
+  });
+  auto selection = context.registerSelectionVector(len);
+  auto selected_num = func->createVariable(JITTypeTag::INT64, "selected_num", 0);
+
+  // Utilize C2R to generate column load, every row is written into the selection
+  // vector and the count is only advanced for passed rows, so the loop body has no
+  // branches.
+  auto c2r_node = createOpNode<ColumnToRowNode>(utils::collectColumnVars(exprs));
+  auto c2r_translator = c2r_node->toTranslator();
+  c2r_translator->codegen(context, [&](context::CodegenContext& context) {
+    auto passed = func->createVariable(JITTypeTag::BOOL, "passed");
+    *passed = func->createLiteral(JITTypeTag::BOOL, true);
+    for (auto& expr : exprs) {
+      utils::FixSizeJITExprValue cond(expr->codegen(context));
+      passed = passed && cond.getValue() && !cond.getNull();
+    }
+    auto row_index =
+        c2r_node->getRowIndex()->castJITValuePrimitiveType(JITTypeTag::INT32);
+    auto selection_slot = selection[*selected_num];
+    selection_slot = *row_index;
+    selected_num = selected_num + *passed->castJITValuePrimitiveType(JITTypeTag::INT64);
+  });
+
+  auto name = context.registerFilter();
+  if (context.getCodegenOptions().enable_runtime_profile) {
+    auto input_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kFilterInput, name);
+    auto output_counter =
+        context.registerProfileCounter(context::ProfileCounterKind::kFilterOutput, name);
+    context.codegenProfileCounterAdd(input_counter, *len);
+    context.codegenProfileCounterAdd(output_counter, *selected_num);
+  }
+
+  context.setFilterSelection(selection, selected_num);
+  successor_wrapper(successor, context);
+}
+}  // namespace cider::exec::nextgen::operators
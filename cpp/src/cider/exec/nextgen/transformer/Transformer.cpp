@@ -20,11 +20,15 @@
  */
 #include "exec/nextgen/transformer/Transformer.h"
 
+#include "cider/CiderOptions.h"
 #include "exec/nextgen/operators/ColumnToRowNode.h"
+#include "exec/nextgen/operators/FilterNode.h"
+#include "exec/nextgen/operators/HashJoinNode.h"
 #include "exec/nextgen/operators/OpNode.h"
 #include "exec/nextgen/operators/ProjectNode.h"
 #include "exec/nextgen/operators/QueryFuncInitializer.h"
 #include "exec/nextgen/operators/RowToColumnNode.h"
+#include "exec/nextgen/operators/VectorizedFilterNode.h"
 #include "exec/nextgen/operators/VectorizedProjectNode.h"
 #include "exec/nextgen/utils/ExprUtils.h"
 
@@ -37,7 +41,7 @@ class PipelineStage {
   PipelineStage(const OpPipeline::iterator& head, const OpPipeline::iterator& tail)
       : head_(head), tail_(tail) {}
 
-  void generateLoopStage(OpPipeline& pipeline) {
+  void generateLoopStage(OpPipeline& pipeline, bool bounded_output) {
     // Insert C2R and R2C for row-based stage.
     if (auto&& [type, _] = head_->get()->getOutputExprs();
         type == JITExprValueType::ROW) {
@@ -49,6 +53,11 @@ class PipelineStage {
       ColumnToRowNode* c2r = dynamic_cast<ColumnToRowNode*>(head_->get());
       CHECK(c2r);
       tail_ = pipeline.insert(++tail_, createOpNode<RowToColumnNode>(exprs, c2r));
+
+      // Resume cursor keeps the match position of one join only.
+      if (int64_t join_num = countNodes<HashJoinNode>(); bounded_output && join_num < 2) {
+        c2r->setResumable(join_num > 0);
+      }
     }
   }
 
@@ -70,6 +79,13 @@ class PipelineStage {
   }
 
  private:
+  template <typename NodeT>
+  int64_t countNodes() const {
+    auto end = tail_;
+    ++end;
+    return std::count_if(head_, end, [](const OpNodePtr& op) { return isa<NodeT>(op); });
+  }
+
   ExprPtrVector collectColumnVar() {
     auto end = tail_;
     ++end;
@@ -146,12 +162,35 @@ TranslatorPtr Transformer::toTranslator(OpPipeline& pipeline,
     }
   }
 
+  // Vectorize Filter Transformation
+  // The project transformation may have erased the last node of the pipeline.
+  if (co.enable_vectorize && !FLAGS_null_separate && traverse_pivot != pipeline.end() &&
+      isa<FilterNode>(*traverse_pivot) && traverse_pivot != --pipeline.end()) {
+    // Filters over fixed-size columns are evaluated batch-at-a-time into a selection
+    // vector, the rest of the pipeline only loops over the selected rows.
+    auto&& [_, exprs] = traverse_pivot->get()->getOutputExprs();
+    auto input_columns = utils::collectColumnVars(exprs);
+    if (std::all_of(input_columns.begin(), input_columns.end(), [](const ExprPtr& col) {
+          return col->isAutoVectorizable();
+        })) {
+      *traverse_pivot = createOpNode<VectorizedFilterNode>(exprs);
+      stages.emplace_back(traverse_pivot, traverse_pivot);
+      ++traverse_pivot;
+    }
+  }
+
   if (traverse_pivot != pipeline.end()) {
     stages.emplace_back(traverse_pivot, --pipeline.end());
   }
 
+  // Output of vectorized projects is not bounded, pipelines with them are never bounded.
+  bool bounded_output =
+      co.max_output_rows > 0 && !FLAGS_null_separate &&
+      std::none_of(pipeline.begin(), pipeline.end(), [](const OpNodePtr& op) {
+        return isa<VectorizedProjectNode>(op);
+      });
   for (auto&& stage : stages) {
-    stage.generateLoopStage(pipeline);
+    stage.generateLoopStage(pipeline, bounded_output);
   }
 
   return generateTranslators(pipeline);
@@ -150,6 +150,7 @@ inline bool isVectorizableType(SQLTypes type) {
     case kBIGINT:
     case kFLOAT:
     case kDOUBLE:
+    case kDATE:
       return true;
     default:
       return false;
@@ -19,14 +19,22 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <string_view>
 
 #include "cider/CiderException.h"
+#include "exec/module/batch/CiderArrowBufferHolder.h"
 #include "exec/nextgen/context/CodegenContext.h"
 #include "exec/plan/parser/SubstraitToRelAlgExecutionUnit.h"
 #include "exec/processor/DefaultBatchProcessor.h"
 #include "exec/processor/StatefulProcessor.h"
 #include "exec/processor/StatelessProcessor.h"
+#include "util/threading.h"
 
 namespace cider::exec::processor {
 
@@ -49,12 +57,78 @@ std::string getErrorMessageFromErrCode(const cider::jitlib::ERROR_CODE error_cod
   }
 }
 
+namespace {
+// Only string columns with INT32 dictionary indices and columns with INT32 run ends are
+// read natively, other encoded columns have to be decoded by the caller. String views
+// are an output layout only, input strings are read through offsets.
+void checkInputEncodings(const struct ArrowSchema* schema) {
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    auto child = schema->children[i];
+    if (child->format[0] == 'v') {
+      CIDER_THROW(CiderUnsupportedException,
+                  fmt::format("Unsupported string view input column {}, format: {}",
+                              i,
+                              child->format));
+    }
+    if (std::string_view(child->format) == "+r") {
+      std::string_view run_end_format(child->children[0]->format);
+      if (run_end_format != "i") {
+        CIDER_THROW(CiderUnsupportedException,
+                    fmt::format("Unsupported run-end encoded input column {}, run end "
+                                "format: {}",
+                                i,
+                                run_end_format));
+      }
+      continue;
+    }
+    if (!child->dictionary) {
+      continue;
+    }
+    std::string_view index_format(child->format);
+    std::string_view value_format(child->dictionary->format);
+    if (index_format != "i" || value_format != "u") {
+      CIDER_THROW(CiderUnsupportedException,
+                  fmt::format("Unsupported dictionary-encoded input column {}, index "
+                              "format: {}, value format: {}",
+                              i,
+                              index_format,
+                              value_format));
+    }
+  }
+}
+
+// Bytes of values and validity of a flat batch.
+int64_t getArrowArrayBytes(const struct ArrowArray* array,
+                           const struct ArrowSchema* schema) {
+  int64_t bytes = 0;
+  for (int64_t i = 0; i < array->n_children; ++i) {
+    auto child = array->children[i];
+    bytes += (child->length + 7) / 8;
+    if (child->n_buffers == 3) {
+      auto offsets = reinterpret_cast<const int32_t*>(child->buffers[1]) + child->offset;
+      bytes += (child->length + 1) * sizeof(int32_t);
+      bytes += offsets[child->length] - offsets[0];
+    } else {
+      auto value_bytes = nextgen::context::batch_runtime_utils::getArrowFormatValueBytes(
+          schema->children[i]->format);
+      bytes += value_bytes ? child->length * value_bytes : (child->length + 7) / 8;
+    }
+  }
+  return bytes;
+}
+}  // namespace
+
 DefaultBatchProcessor::DefaultBatchProcessor(
     const plan::SubstraitPlanPtr& plan,
     const BatchProcessorContextPtr& context,
     const cider::exec::nextgen::context::CodegenOptions& codegen_options)
-    : plan_(plan), context_(context) {
-  auto allocator = context->getAllocator();
+    : plan_(plan)
+    , context_(context)
+    , buffer_pool_(std::make_shared<CiderPoolAllocator>(context->getAllocator())) {
+  auto options = codegen_options;
+  if (context_->getMaxOutputRows() > 0) {
+    options.max_output_rows = context_->getMaxOutputRows();
+  }
   if (plan_->hasJoinRel()) {
     // TODO: currently we can't distinguish the joinRel is either a hashJoin rel
     // or a mergeJoin rel, just hard-code as HashJoinHandler for now and will refactor to
@@ -66,15 +140,67 @@ DefaultBatchProcessor::DefaultBatchProcessor(
     this->state_ = BatchProcessorState::kWaiting;
   }
 
+  compile(options);
+}
+
+DefaultBatchProcessor::~DefaultBatchProcessor() {
+  releaseBufferedInput();
+  for (auto schema : {&buffered_schema_, &deferred_schema_}) {
+    if (schema->release) {
+      schema->release(schema);
+    }
+  }
+  if (deferred_array_.release) {
+    deferred_array_.release(&deferred_array_);
+  }
+}
+
+void DefaultBatchProcessor::compile(
+    const cider::exec::nextgen::context::CodegenOptions& codegen_options) {
   auto translator =
       std::make_shared<generator::SubstraitToRelAlgExecutionUnit>(plan_->getPlan());
   RelAlgExecutionUnit ra_exe_unit = translator->createRelAlgExecutionUnit();
-  codegen_context_ = nextgen::compile(ra_exe_unit, codegen_options);
-  runtime_context_ = codegen_context_->generateRuntimeCTX(allocator);
+  codegen_options_ = codegen_options;
+  auto codegen_context = nextgen::compile(ra_exe_unit, codegen_options);
+  if (hash_table_) {
+    codegen_context->setHashTable(hash_table_.get());
+  }
+  auto runtime_context = codegen_context->generateRuntimeCTX(buffer_pool_);
+  runtime_context->setInterruptFlag(interrupted_);
+  if (context_->getInterruptChecker()) {
+    runtime_context->setInterruptChecker(context_->getInterruptChecker());
+  }
+  codegen_context_ = std::move(codegen_context);
+  runtime_context_ = std::move(runtime_context);
+  worker_contexts_.clear();
   query_func_ = reinterpret_cast<nextgen::QueryFunc>(
       codegen_context_->getJITFunction()->getFunctionPointer<void, int8_t*, int8_t*>());
 }
 
+void DefaultBatchProcessor::recompileWithRuntimeProfile() {
+  auto profile = runtime_context_->getRuntimeProfile();
+  LOG(INFO) << "Recompile with runtime profile of " << processed_batch_num_
+            << " batches:\n"
+            << profile.toString();
+
+  auto codegen_options = codegen_options_;
+  codegen_options.enable_runtime_profile = false;
+  // Branching logic is cheaper once filter outcomes are predictable, otherwise keep
+  // branchless logic to avoid mispredictions.
+  constexpr double kPredictableSelectivity = 0.05;
+  auto& selectivity = profile.filter_selectivity;
+  codegen_options.branchless_logic =
+      selectivity.empty() ||
+      !std::all_of(selectivity.begin(), selectivity.end(), [](const auto& filter) {
+        return filter.second < kPredictableSelectivity ||
+               filter.second > 1 - kPredictableSelectivity;
+      });
+  codegen_options.conjunct_selectivity =
+      std::make_shared<std::unordered_map<std::string, double>>(
+          profile.conjunct_selectivity.begin(), profile.conjunct_selectivity.end());
+  compile(codegen_options);
+}
+
 void DefaultBatchProcessor::processNextBatch(const struct ArrowArray* array,
                                              const struct ArrowSchema* schema) {
   if (BatchProcessorState::kRunning != state_) {
@@ -82,6 +208,33 @@ void DefaultBatchProcessor::processNextBatch(const struct ArrowArray* array,
                 "DefaultBatchProcessor::processNextBatch can only be called if state is "
                 "kRunning.");
   }
+  if (hasPendingOutput()) {
+    CIDER_THROW(CiderRuntimeException,
+                "DefaultBatchProcessor::processNextBatch can only be called once output "
+                "of last batch has been fetched.");
+  }
+  if (schema) {
+    checkInputEncodings(schema);
+  }
+  ++input_batch_num_;
+  input_row_num_ += array->length;
+  if (context_->getMinInputRows() > 0 || context_->getMinInputBytes() > 0) {
+    coalesceInput(array, schema);
+    return;
+  }
+  processBatch(array, schema);
+}
+
+void DefaultBatchProcessor::processBatch(const struct ArrowArray* array,
+                                         const struct ArrowSchema* schema) {
+  // Output of stateless processors has been fetched by getResult, so the runtime
+  // context can be replaced safely.
+  if (codegen_options_.enable_runtime_profile && !has_result_ &&
+      processed_batch_num_ >= codegen_options_.profile_batch_num &&
+      getProcessorType() == Type::kStateless) {
+    recompileWithRuntimeProfile();
+  }
+
   if (joinHandler_) {
     // this->inputBatch_ = joinHandler_->onProcessBatch(batch);
   } else {
@@ -89,13 +242,28 @@ void DefaultBatchProcessor::processNextBatch(const struct ArrowArray* array,
     input_arrow_schema_ = schema;
   }
 
-  int ret = query_func_((int8_t*)runtime_context_.get(), (int8_t*)array);
-  if (ret != 0) {
-    CIDER_THROW(CiderRuntimeException,
-                getErrorMessageFromErrCode(static_cast<cider::jitlib::ERROR_CODE>(ret)));
+  std::shared_ptr<const ArrowArray> input;
+  if (!need_spill_) {
+    // Move the input into a ref-counted holder, passthrough output columns share its
+    // buffers and keep it alive until the output batch is released.
+    input.reset(new ArrowArray(*array), [](ArrowArray* input) {
+      if (input->release) {
+        input->release(input);
+      }
+      delete input;
+    });
+    const_cast<struct ArrowArray*>(array)->release = nullptr;
+  }
+  runtime_context_->resetResumeCursor();
+  if (!runMorsels(array, schema, input)) {
+    runQueryFunc(array, input);
+  }
+  if (runtime_context_->hasPendingOutput()) {
+    pending_input_ = std::move(input);
   }
 
   has_result_ = true;
+  ++processed_batch_num_;
 
   if (!need_spill_) {
     if (input_arrow_array_->release) {
@@ -110,6 +278,311 @@ void DefaultBatchProcessor::processNextBatch(const struct ArrowArray* array,
   }
 }
 
+void DefaultBatchProcessor::runQueryFunc(const struct ArrowArray* array,
+                                         const std::shared_ptr<const ArrowArray>& input) {
+  auto time_limit = context_->getTimeLimit();
+  if (time_limit.count() > 0) {
+    runtime_context_->setDeadline(nextgen::context::RuntimeContext::Clock::now() +
+                                  time_limit);
+  }
+  // Generated loops only poll every interrupt_check_interval rows, check once ahead so
+  // that a cancelled processor never starts a new batch.
+  int ret = runtime_context_->checkInterrupt();
+  if (ret == 0) {
+    runtime_context_->setInputArray(input);
+    ret = query_func_((int8_t*)runtime_context_.get(),
+                      (int8_t*)(input ? input.get() : array));
+    runtime_context_->setInputArray(nullptr);
+  }
+  runtime_context_->clearDeadline();
+  if (ret != 0) {
+    CIDER_THROW(CiderRuntimeException,
+                getErrorMessageFromErrCode(static_cast<cider::jitlib::ERROR_CODE>(ret)));
+  }
+}
+
+bool DefaultBatchProcessor::runMorsels(const struct ArrowArray* array,
+                                       const struct ArrowSchema* schema,
+                                       const std::shared_ptr<const ArrowArray>& input) {
+  int parallelism = context_->getParallelism();
+  int64_t morsel_size = (context_->getMorselSize() + 7) / 8 * 8;
+  if (parallelism <= 1 || morsel_size <= 0 || !schema || array->length <= morsel_size ||
+      getProcessorType() != Type::kStateless || joinHandler_ ||
+      codegen_options_.max_output_rows > 0 || codegen_options_.enable_runtime_profile) {
+    return false;
+  }
+
+  namespace batch_runtime_utils = nextgen::context::batch_runtime_utils;
+  auto input_array = input ? input.get() : array;
+  int64_t morsel_num = (array->length + morsel_size - 1) / morsel_size;
+  std::vector<batch_runtime_utils::ArrowArraySlice> morsels(morsel_num);
+  for (int64_t i = 0; i < morsel_num; ++i) {
+    auto begin = i * morsel_size;
+    auto len = std::min(morsel_size, array->length - begin);
+    if (!batch_runtime_utils::sliceArrowArray(
+            morsels[i], input_array, schema, begin, len)) {
+      return false;
+    }
+  }
+
+  if (worker_contexts_.size() != static_cast<size_t>(parallelism)) {
+    worker_contexts_.clear();
+    auto interrupt_checker = context_->getInterruptChecker();
+    for (int i = 0; i < parallelism; ++i) {
+      auto worker_context = codegen_context_->generateRuntimeCTX(buffer_pool_);
+      // Workers stop once the processor is cancelled or any worker is interrupted.
+      worker_context->setInterruptFlag(interrupted_);
+      if (interrupt_checker) {
+        worker_context->setInterruptChecker(interrupt_checker);
+      }
+      worker_contexts_.emplace_back(std::move(worker_context));
+    }
+  }
+
+  int ret = runtime_context_->checkInterrupt();
+  if (ret != 0) {
+    CIDER_THROW(CiderRuntimeException,
+                getErrorMessageFromErrCode(static_cast<cider::jitlib::ERROR_CODE>(ret)));
+  }
+  auto time_limit = context_->getTimeLimit();
+  for (auto& worker_context : worker_contexts_) {
+    if (time_limit.count() > 0) {
+      worker_context->setDeadline(nextgen::context::RuntimeContext::Clock::now() +
+                                  time_limit);
+    }
+  }
+
+  // Morsels are taken by idle workers in input order, output of each morsel is moved
+  // out of the worker to be concatenated once all morsels are done.
+  std::vector<std::pair<ArrowSchema, ArrowArray>> fragments(morsel_num);
+  for (auto& [fragment_schema, fragment_array] : fragments) {
+    fragment_schema.release = nullptr;
+    fragment_array.release = nullptr;
+  }
+  std::atomic<int64_t> next_morsel{0};
+  std::atomic<bool> failed{false};
+  std::atomic<int32_t> error_code{0};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  threading::task_group workers;
+  for (auto& worker_context : worker_contexts_) {
+    workers.run([&, worker = worker_context.get()]() {
+      try {
+        for (auto i = next_morsel++; i < morsel_num && !failed; i = next_morsel++) {
+          worker->setInputArray(input);
+          auto ret = query_func_((int8_t*)worker, (int8_t*)&morsels[i].array);
+          worker->setInputArray(nullptr);
+          if (ret != 0) {
+            error_code = ret;
+            failed = true;
+            break;
+          }
+          auto output_batch = worker->getOutputBatch();
+          output_batch->move(fragments[i].first, fragments[i].second);
+          worker->resetBatch(buffer_pool_);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        exception = std::current_exception();
+        failed = true;
+      }
+    });
+  }
+  workers.wait();
+
+  for (auto& worker_context : worker_contexts_) {
+    worker_context->clearDeadline();
+  }
+  auto release_fragments = [&fragments]() {
+    for (auto& [fragment_schema, fragment_array] : fragments) {
+      if (fragment_schema.release) {
+        fragment_schema.release(&fragment_schema);
+      }
+      if (fragment_array.release) {
+        fragment_array.release(&fragment_array);
+      }
+    }
+  };
+  if (exception) {
+    release_fragments();
+    std::rethrow_exception(exception);
+  }
+  if (error_code != 0) {
+    release_fragments();
+    CIDER_THROW(CiderRuntimeException,
+                getErrorMessageFromErrCode(
+                    static_cast<cider::jitlib::ERROR_CODE>(error_code.load())));
+  }
+
+  auto output_batch = runtime_context_->getOutputBatch();
+  auto output_array = output_batch->getArray();
+  auto output_schema = output_batch->getSchema();
+  std::vector<const ArrowArray*> columns(morsel_num);
+  for (int64_t i = 0; i < output_array->n_children; ++i) {
+    for (int64_t j = 0; j < morsel_num; ++j) {
+      columns[j] = fragments[j].second.children[i];
+    }
+    auto value_bytes =
+        batch_runtime_utils::getArrowFormatValueBytes(output_schema->children[i]->format);
+    batch_runtime_utils::concatArrowArrays(
+        output_array->children[i], columns, value_bytes);
+  }
+  release_fragments();
+  return true;
+}
+
+void DefaultBatchProcessor::coalesceInput(const struct ArrowArray* array,
+                                          const struct ArrowSchema* schema) {
+  if (!canCoalesce(array, schema)) {
+    if (buffered_inputs_.empty()) {
+      processBatch(array, schema);
+      return;
+    }
+    flushInput();
+    if (getProcessorType() == Type::kStateless) {
+      // Output of buffered input has to be fetched first.
+      deferred_array_ = *array;
+      const_cast<struct ArrowArray*>(array)->release = nullptr;
+      deferred_schema_.release = nullptr;
+      if (schema) {
+        deferred_schema_ = *schema;
+        const_cast<struct ArrowSchema*>(schema)->release = nullptr;
+      }
+      has_deferred_input_ = true;
+    } else {
+      processBatch(array, schema);
+    }
+    return;
+  }
+
+  if (buffered_inputs_.empty()) {
+    buffered_schema_ = *schema;
+    buffered_since_ = std::chrono::steady_clock::now();
+  } else if (schema->release) {
+    const_cast<struct ArrowSchema*>(schema)->release(
+        const_cast<struct ArrowSchema*>(schema));
+  }
+  const_cast<struct ArrowSchema*>(schema)->release = nullptr;
+  buffered_inputs_.push_back(*array);
+  const_cast<struct ArrowArray*>(array)->release = nullptr;
+  buffered_rows_ += array->length;
+  buffered_bytes_ += getArrowArrayBytes(&buffered_inputs_.back(), &buffered_schema_);
+
+  auto min_rows = context_->getMinInputRows();
+  auto min_bytes = context_->getMinInputBytes();
+  if ((min_rows > 0 && buffered_rows_ >= min_rows) ||
+      (min_bytes > 0 && buffered_bytes_ >= min_bytes)) {
+    flushInput();
+  }
+}
+
+bool DefaultBatchProcessor::canCoalesce(const struct ArrowArray* array,
+                                        const struct ArrowSchema* schema) const {
+  if (joinHandler_ || !schema || schema->n_children != array->n_children ||
+      (!buffered_inputs_.empty() && buffered_schema_.n_children != schema->n_children)) {
+    return false;
+  }
+  for (int64_t i = 0; i < array->n_children; ++i) {
+    auto child = array->children[i];
+    std::string_view format(schema->children[i]->format);
+    if (child->dictionary || child->n_children > 0 || child->length != array->length ||
+        (format != "u" &&
+         nextgen::context::batch_runtime_utils::getArrowFormatValueBytes(format) < 0)) {
+      return false;
+    }
+    if (!buffered_inputs_.empty() && format != buffered_schema_.children[i]->format) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DefaultBatchProcessor::flushInputIfDue() {
+  // Output of stateless processors is replaced by the next run, so it has to be fetched
+  // first.
+  if (buffered_inputs_.empty() || hasPendingOutput() ||
+      (has_result_ && getProcessorType() == Type::kStateless)) {
+    return;
+  }
+  auto max_delay = context_->getMaxInputDelay();
+  auto buffered_time = std::chrono::steady_clock::now() - buffered_since_;
+  if (no_more_batch_ || (max_delay.count() > 0 && buffered_time >= max_delay)) {
+    flushInput();
+  }
+}
+
+void DefaultBatchProcessor::flushInput() {
+  CHECK(!buffered_inputs_.empty());
+  ArrowArray input;
+  if (buffered_inputs_.size() == 1) {
+    input = buffered_inputs_.front();
+    buffered_inputs_.front().release = nullptr;
+  } else {
+    // Concatenate buffered batches into a flat batch allocated from the buffer pool.
+    auto new_array = [this](int64_t buffer_num, int64_t children_num, int64_t length) {
+      auto holder =
+          new CiderArrowArrayBufferHolder(buffer_num, children_num, buffer_pool_, false);
+      return ArrowArray{.length = length,
+                        .null_count = 0,
+                        .offset = 0,
+                        .n_buffers = buffer_num,
+                        .n_children = children_num,
+                        .buffers = holder->getBufferPtrs(),
+                        .children = holder->getChildrenPtrs(),
+                        .dictionary = nullptr,
+                        .release = CiderBatchUtils::ciderArrowArrayReleaser,
+                        .private_data = holder};
+    };
+    auto children_num = buffered_schema_.n_children;
+    input = new_array(1, children_num, buffered_rows_);
+    std::vector<const ArrowArray*> columns(buffered_inputs_.size());
+    for (int64_t i = 0; i < children_num; ++i) {
+      auto child_schema = buffered_schema_.children[i];
+      *input.children[i] =
+          new_array(CiderBatchUtils::getBufferNum(child_schema), 0, buffered_rows_);
+      for (size_t j = 0; j < buffered_inputs_.size(); ++j) {
+        columns[j] = buffered_inputs_[j].children[i];
+      }
+      auto value_bytes =
+          nextgen::context::batch_runtime_utils::getArrowFormatValueBytes(
+              child_schema->format);
+      nextgen::context::batch_runtime_utils::concatArrowArrays(
+          input.children[i], columns, value_bytes);
+    }
+  }
+  releaseBufferedInput();
+  auto schema = buffered_schema_;
+  buffered_schema_.release = nullptr;
+  processBatch(&input, &schema);
+}
+
+void DefaultBatchProcessor::releaseBufferedInput() {
+  for (auto& buffered_input : buffered_inputs_) {
+    if (buffered_input.release) {
+      buffered_input.release(&buffered_input);
+    }
+  }
+  buffered_inputs_.clear();
+  buffered_rows_ = 0;
+  buffered_bytes_ = 0;
+}
+
+void DefaultBatchProcessor::continueOutput() {
+  if (has_deferred_input_) {
+    has_deferred_input_ = false;
+    processBatch(&deferred_array_,
+                 deferred_schema_.release ? &deferred_schema_ : nullptr);
+    return;
+  }
+  CHECK(runtime_context_->hasPendingOutput());
+  runtime_context_->resumeOutput();
+  runQueryFunc(input_arrow_array_, pending_input_);
+  if (!runtime_context_->hasPendingOutput()) {
+    pending_input_.reset();
+  }
+  has_result_ = true;
+}
+
 BatchProcessorState DefaultBatchProcessor::getState() {
   if (joinHandler_) {
     joinHandler_->onState(state_);
@@ -117,8 +590,13 @@ BatchProcessorState DefaultBatchProcessor::getState() {
   return state_;
 }
 
+void DefaultBatchProcessor::cancel() {
+  interrupted_->store(true, std::memory_order_relaxed);
+}
+
 void DefaultBatchProcessor::finish() {
   no_more_batch_ = true;
+  flushInputIfDue();
   if (joinHandler_) {
     joinHandler_->onFinish();
   }
@@ -128,6 +606,7 @@ void DefaultBatchProcessor::feedHashBuildTable(
     const std::shared_ptr<JoinHashTable>& hashTable) {
   // switch state from waiting to running once hashTable is ready
   this->state_ = BatchProcessorState::kRunning;
+  this->hash_table_ = hashTable;
   this->codegen_context_->setHashTable(hashTable.get());
 }
 
@@ -36,26 +36,89 @@ class DefaultBatchProcessor : public BatchProcessor {
       const BatchProcessorContextPtr& context,
       const cider::exec::nextgen::context::CodegenOptions& codegen_options = {});
 
-  virtual ~DefaultBatchProcessor() = default;
+  virtual ~DefaultBatchProcessor();
 
   const BatchProcessorContextPtr& getContext() const override { return context_; }
 
   void processNextBatch(const struct ArrowArray* array,
                         const struct ArrowSchema* schema = nullptr) override;
 
+  bool hasPendingOutput() const override {
+    return runtime_context_->hasPendingOutput() || has_deferred_input_;
+  }
+
   void finish() override;
 
   BatchProcessorState getState() override;
 
+  void cancel() override;
+
+  nextgen::context::RuntimeProfile getRuntimeProfile() const {
+    return runtime_context_->getRuntimeProfile();
+  }
+
+  // Batches and rows added by processNextBatch, and batches run by the query function,
+  // which are fewer if input is coalesced (see BatchProcessorContext::setMinInputRows).
+  int64_t getInputBatchNum() const { return input_batch_num_; }
+
+  int64_t getInputRowNum() const { return input_row_num_; }
+
+  int64_t getProcessedBatchNum() const { return processed_batch_num_; }
+
   void feedHashBuildTable(const std::shared_ptr<JoinHashTable>& hashTable) override;
 
   void feedCrossBuildData(const std::shared_ptr<Batch>& crossData) override;
 
  protected:
+  void compile(const cider::exec::nextgen::context::CodegenOptions& codegen_options);
+
+  // Replaces the instrumented query function with one optimized for the measured
+  // runtime profile.
+  void recompileWithRuntimeProfile();
+
+  // Runs the query function over an input batch, output is available once it returns.
+  void processBatch(const struct ArrowArray* array, const struct ArrowSchema* schema);
+
+  // Buffers the input batch until enough input is buffered, batches which can't be
+  // concatenated are run on their own after buffered ones.
+  void coalesceInput(const struct ArrowArray* array, const struct ArrowSchema* schema);
+
+  // Returns true if the batch has flat columns of the same layout as buffered batches.
+  bool canCoalesce(const struct ArrowArray* array,
+                   const struct ArrowSchema* schema) const;
+
+  // Runs buffered input if no more batch will come or the latency bound has passed, and
+  // if the output of last run has been fetched.
+  void flushInputIfDue();
+
+  // Runs buffered input as one batch.
+  void flushInput();
+
+  void releaseBufferedInput();
+
+  // Runs the query function over input (array if not held), throws on errors.
+  void runQueryFunc(const struct ArrowArray* array,
+                    const std::shared_ptr<const ArrowArray>& input);
+
+  // Generates the next output batch of last input batch, only valid if
+  // hasPendingOutput().
+  void continueOutput();
+
+  // Runs the query function over morsels of input on worker threads (see
+  // BatchProcessorContext::setParallelism) and concatenates their output. Returns false
+  // without running anything if morsels are disabled or input can't be sliced.
+  bool runMorsels(const struct ArrowArray* array,
+                  const struct ArrowSchema* schema,
+                  const std::shared_ptr<const ArrowArray>& input);
+
   plan::SubstraitPlanPtr plan_;
 
   BatchProcessorContextPtr context_;
 
+  // Allocator of runtime buffers (including output batches), recycles buffers released
+  // by consumers for later batches.
+  std::shared_ptr<CiderAllocator> buffer_pool_;
+
   BatchProcessorState state_{BatchProcessorState::kRunning};
 
   const struct ArrowArray* input_arrow_array_{nullptr};
@@ -71,9 +134,40 @@ class DefaultBatchProcessor : public BatchProcessor {
 
   JoinHandlerPtr joinHandler_;
 
+  std::shared_ptr<JoinHashTable> hash_table_;
+
+  nextgen::context::CodegenOptions codegen_options_;
+  int64_t processed_batch_num_{0};
+
   nextgen::context::CodegenCtxPtr codegen_context_;
   nextgen::context::RuntimeCtxPtr runtime_context_;
   nextgen::QueryFunc query_func_;
+
+  // Runtime contexts of morsel workers, created on first use.
+  std::vector<nextgen::context::RuntimeCtxPtr> worker_contexts_;
+
+  // Shared by all runtime contexts, set by cancel() which may run concurrently with a
+  // recompilation replacing the contexts.
+  nextgen::context::RuntimeContext::InterruptFlag interrupted_{
+      std::make_shared<std::atomic<bool>>(false)};
+
+  int64_t input_batch_num_{0};
+  int64_t input_row_num_{0};
+
+  // Input batches buffered to be coalesced, all described by the schema of the first.
+  std::vector<ArrowArray> buffered_inputs_;
+  ArrowSchema buffered_schema_{.release = nullptr};
+  int64_t buffered_rows_{0};
+  int64_t buffered_bytes_{0};
+  std::chrono::steady_clock::time_point buffered_since_;
+
+  // Input batch which can't be coalesced, run once output of buffered input is fetched.
+  bool has_deferred_input_{false};
+  ArrowArray deferred_array_{.release = nullptr};
+  ArrowSchema deferred_schema_{.release = nullptr};
+
+  // Input batch with pending output, kept until its output is fully generated.
+  std::shared_ptr<const ArrowArray> pending_input_;
 };
 
 }  // namespace cider::exec::processor
@@ -34,6 +34,7 @@ StatefulProcessor::StatefulProcessor(
 }
 
 void StatefulProcessor::getResult(struct ArrowArray& array, struct ArrowSchema& schema) {
+  flushInputIfDue();
   if (!no_more_batch_ || !has_result_) {
     array.length = 0;
     return;
@@ -24,6 +24,11 @@
 namespace cider::exec::processor {
 
 void StatelessProcessor::getResult(struct ArrowArray& array, struct ArrowSchema& schema) {
+  if (!has_result_ && hasPendingOutput()) {
+    // Output of last batch is bounded by max output rows, generate its next part.
+    continueOutput();
+  }
+  flushInputIfDue();
   if (!has_result_) {
     if (no_more_batch_) {
       // set state as finish if last batch has been processed and no more batch
@@ -37,7 +42,7 @@ void StatelessProcessor::getResult(struct ArrowArray& array, struct ArrowSchema&
 
   auto output_batch = runtime_context_->getOutputBatch();
   output_batch->move(schema, array);
-  runtime_context_->resetBatch(context_->getAllocator());
+  runtime_context_->resetBatch(buffer_pool_);
   return;
 }
 
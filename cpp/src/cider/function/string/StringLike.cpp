@@ -21,6 +21,10 @@
  */
 #include "StringLike.h"
 
+#include <cstring>
+
+#include "util/CiderCpuDispatch.h"
+
 enum LikeStatus {
   kLIKE_TRUE,
   kLIKE_FALSE,
@@ -40,16 +44,10 @@ extern "C" RUNTIME_EXPORT bool string_like_simple(const char* str,
                                                   const int32_t str_len,
                                                   const char* pattern,
                                                   const int32_t pat_len) {
-  int i, j;
-  int search_len = str_len - pat_len + 1;
-  for (i = 0; i < search_len; ++i) {
-    for (j = 0; j < pat_len && pattern[j] == str[j + i]; ++j) {
-    }
-    if (j >= pat_len) {
-      return true;
-    }
+  if (str_len < pat_len) {
+    return false;
   }
-  return false;
+  return CiderCpuDispatch::getKernels().find_str(str, str_len, pattern, pat_len) >= 0;
 }
 
 extern "C" RUNTIME_EXPORT bool string_ilike_simple(const char* str,
@@ -260,6 +258,52 @@ extern "C" RUNTIME_EXPORT bool string_ilike(const char* str,
   return status == kLIKE_TRUE;
 }
 
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int32_t
+string_like_match_at(const char* str,
+                     const int32_t str_len,
+                     const int32_t pos,
+                     const int32_t skip,
+                     const char* lit,
+                     const int32_t lit_len) {
+  if (pos < 0 || pos + skip + lit_len > str_len) {
+    return -1;
+  }
+  return std::memcmp(str + pos + skip, lit, lit_len) ? -1 : pos + skip + lit_len;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int32_t
+string_like_find(const char* str,
+                 const int32_t str_len,
+                 const int32_t pos,
+                 const int32_t skip,
+                 const char* lit,
+                 const int32_t lit_len) {
+  const int32_t start = pos + skip;
+  if (pos < 0 || start + lit_len > str_len) {
+    return -1;
+  }
+  // first/last byte filtered SIMD search of the host ISA level
+  int64_t found = CiderCpuDispatch::getKernels().find_str(
+      str + start, str_len - start, lit, lit_len);
+  return found < 0 ? -1 : start + found + lit_len;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE int32_t
+string_like_align_end(const int32_t str_len,
+                      const int32_t pos,
+                      const int32_t skip,
+                      const int32_t block_len) {
+  return pos < 0 || str_len - block_len < pos + skip ? -1 : str_len - block_len;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE bool
+string_like_end(const int32_t str_len,
+                const int32_t pos,
+                const int32_t skip,
+                const bool exact) {
+  return pos >= 0 && (exact ? pos + skip == str_len : pos + skip <= str_len);
+}
+
 extern "C" RUNTIME_EXPORT int32_t StringCompare(const char* s1,
                                                 const int32_t s1_len,
                                                 const char* s2,
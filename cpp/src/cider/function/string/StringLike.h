@@ -60,6 +60,39 @@ extern "C" RUNTIME_EXPORT bool string_ilike_simple(const char* str,
                                                    const char* pattern,
                                                    const int32_t pat_len);
 
+// Building blocks of LIKE patterns analyzed at compile time. A pattern is split by '%'
+// into blocks of literals and '_' wildcards, pos is the end of the part matched so far
+// and -1 once the match failed. See Analyzer::LikeExpr::codegen.
+
+// Matches lit at pos + skip, returns the end of lit or -1.
+extern "C" RUNTIME_EXPORT int32_t string_like_match_at(const char* str,
+                                                       const int32_t str_len,
+                                                       const int32_t pos,
+                                                       const int32_t skip,
+                                                       const char* lit,
+                                                       const int32_t lit_len);
+
+// Finds the first lit at or after pos + skip, returns the end of lit or -1.
+extern "C" RUNTIME_EXPORT int32_t string_like_find(const char* str,
+                                                   const int32_t str_len,
+                                                   const int32_t pos,
+                                                   const int32_t skip,
+                                                   const char* lit,
+                                                   const int32_t lit_len);
+
+// Returns the start of the last block_len bytes of str, or -1 if they start before
+// pos + skip.
+extern "C" RUNTIME_EXPORT int32_t string_like_align_end(const int32_t str_len,
+                                                        const int32_t pos,
+                                                        const int32_t skip,
+                                                        const int32_t block_len);
+
+// Whether skip more bytes after pos reach the end of str, or fit in str if !exact.
+extern "C" RUNTIME_EXPORT bool string_like_end(const int32_t str_len,
+                                               const int32_t pos,
+                                               const int32_t skip,
+                                               const bool exact);
+
 extern "C" RUNTIME_EXPORT bool string_lt(const char* lhs,
                                          const int32_t lhs_len,
                                          const char* rhs,
@@ -24,6 +24,9 @@
 
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "cider/CiderException.h"
 
@@ -219,4 +222,95 @@ class CiderArenaAllocator : public CiderAllocator {
   std::shared_ptr<CiderAllocator> parent_;
 };
 
+// Keeps freed blocks and hands them out again for allocations of the same size class
+// instead of going through parent, so buffers of similar sized batches are recycled.
+// Sizes are rounded up to powers of two, at most max_pooled_bytes are kept in the pool.
+// Blocks which don't fit in the pool are allocated in their exact size and bypass it.
+// Blocks may be freed from any thread.
+class CiderPoolAllocator : public CiderAllocator {
+  static constexpr size_t kMinBlockSize = 64;
+  static constexpr size_t kDefaultMaxPooledBytes = 64 << 20;
+
+ public:
+  explicit CiderPoolAllocator(std::shared_ptr<CiderAllocator> parent,
+                              size_t max_pooled_bytes = kDefaultMaxPooledBytes)
+      : parent_(parent), max_pooled_bytes_(max_pooled_bytes) {}
+
+  ~CiderPoolAllocator() {
+    for (auto& [block_size, blocks] : free_blocks_) {
+      for (auto block : blocks) {
+        parent_->deallocate(block, block_size);
+      }
+    }
+  }
+
+  int8_t* allocate(size_t size) final {
+    size_t block_size = getBlockSize(size);
+    if (block_size > max_pooled_bytes_) {
+      return parent_->allocate(block_size);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto iter = free_blocks_.find(block_size);
+      if (iter != free_blocks_.end() && !iter->second.empty()) {
+        auto block = iter->second.back();
+        iter->second.pop_back();
+        pooled_bytes_ -= block_size;
+        return block;
+      }
+    }
+    return parent_->allocate(block_size);
+  }
+
+  void deallocate(int8_t* p, size_t size) final {
+    if (!p) {
+      return;
+    }
+    size_t block_size = getBlockSize(size);
+    if (block_size > max_pooled_bytes_) {
+      parent_->deallocate(p, block_size);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (pooled_bytes_ + block_size <= max_pooled_bytes_) {
+        free_blocks_[block_size].push_back(p);
+        pooled_bytes_ += block_size;
+        return;
+      }
+    }
+    parent_->deallocate(p, block_size);
+  }
+
+  int8_t* reallocate(int8_t* p, size_t size, size_t newSize) final {
+    if (getBlockSize(size) == getBlockSize(newSize)) {
+      return p;
+    }
+    return CiderAllocator::reallocate(p, size, newSize);
+  }
+
+  size_t getCap() override { return parent_->getCap(); }
+  size_t getMemoryUsage() override { return parent_->getMemoryUsage(); }
+
+  size_t getPooledBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooled_bytes_;
+  }
+
+ private:
+  size_t getBlockSize(size_t size) const {
+    size_t block_size = kMinBlockSize;
+    while (block_size < size) {
+      block_size <<= 1;
+    }
+    return block_size <= max_pooled_bytes_ ? block_size : size;
+  }
+
+  std::shared_ptr<CiderAllocator> parent_;
+  const size_t max_pooled_bytes_;
+  std::mutex mutex_;
+  size_t pooled_bytes_{0};
+  std::unordered_map<size_t, std::vector<int8_t*>> free_blocks_;
+};
+
 #endif
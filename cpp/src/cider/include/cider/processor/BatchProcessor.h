@@ -56,12 +56,22 @@ class BatchProcessor : public std::enable_shared_from_this<BatchProcessor> {
   /// Gets an output batch from the batchProcessor.  return null If no output data.
   virtual void getResult(struct ArrowArray& array, struct ArrowSchema& schema) = 0;
 
+  /// Returns true if output of last input batch exceeds the max output rows of context
+  /// and has not been fully fetched by getResult, or if an input batch waits for output
+  /// of coalesced input to be fetched. No more batch can be added until then.
+  virtual bool hasPendingOutput() const = 0;
+
   /// Notifies the batchProcessor that no more batch will be added and the
   /// batchProcessor should finish processing and flush results.
   virtual void finish() = 0;
 
   virtual BatchProcessorState getState() = 0;
 
+  /// Requests the batchProcessor to stop. It may be called from any thread, a running
+  /// processNextBatch will throw CiderRuntimeException shortly after, so do all later
+  /// calls.
+  virtual void cancel() = 0;
+
   virtual Type getProcessorType() const = 0;
 
   virtual void feedHashBuildTable(const std::shared_ptr<JoinHashTable>& hashTable) = 0;
@@ -22,6 +22,7 @@
 #ifndef CIDER_BATCH_PROCESSOR_CONTEXT_H
 #define CIDER_BATCH_PROCESSOR_CONTEXT_H
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -42,6 +43,8 @@ struct HashBuildResult {
 
 using HashBuildTableSupplier = std::function<std::optional<HashBuildResult>()>;
 using CrossBuildTableSupplier = std::function<std::optional<std::shared_ptr<Batch>>()>;
+// Returns true if the host engine asks the query to stop, e.g. the task is aborted.
+using InterruptChecker = std::function<bool()>;
 
 class BatchProcessorContext {
  public:
@@ -67,10 +70,65 @@ class BatchProcessorContext {
     return crossBuildTableSupplier_;
   }
 
+  void setInterruptChecker(const InterruptChecker& interruptChecker) {
+    interruptChecker_ = interruptChecker;
+  }
+
+  const InterruptChecker& getInterruptChecker() const { return interruptChecker_; }
+
+  // Time limit of a single processNextBatch call, zero means no limit.
+  void setTimeLimit(std::chrono::milliseconds timeLimit) { timeLimit_ = timeLimit; }
+
+  std::chrono::milliseconds getTimeLimit() const { return timeLimit_; }
+
+  // Maximum rows of an output batch, zero means no limit. Output of an input batch
+  // exceeding the limit (e.g. exploding joins) is split over several getResult calls.
+  void setMaxOutputRows(int64_t maxOutputRows) { maxOutputRows_ = maxOutputRows; }
+
+  int64_t getMaxOutputRows() const { return maxOutputRows_; }
+
+  // Threads running the query function over row ranges (morsels) of an input batch,
+  // 1 runs it on the calling thread. Only stateless processors without joins or bounded
+  // output run morsels, their output fragments are concatenated in input order.
+  void setParallelism(int parallelism) { parallelism_ = parallelism; }
+
+  int getParallelism() const { return parallelism_; }
+
+  // Rows of a morsel, rounded up to a multiple of 8.
+  void setMorselSize(int64_t morselSize) { morselSize_ = morselSize; }
+
+  int64_t getMorselSize() const { return morselSize_; }
+
+  // Input batches are buffered until they add up to minInputRows rows or minInputBytes
+  // bytes, and then processed as one batch. Zero disables a bound, coalescing is off if
+  // both are zero. Buffered input is processed after finish() or once it has been
+  // buffered for maxInputDelay (checked by getResult), zero means no latency bound.
+  void setMinInputRows(int64_t minInputRows) { minInputRows_ = minInputRows; }
+
+  int64_t getMinInputRows() const { return minInputRows_; }
+
+  void setMinInputBytes(int64_t minInputBytes) { minInputBytes_ = minInputBytes; }
+
+  int64_t getMinInputBytes() const { return minInputBytes_; }
+
+  void setMaxInputDelay(std::chrono::milliseconds maxInputDelay) {
+    maxInputDelay_ = maxInputDelay;
+  }
+
+  std::chrono::milliseconds getMaxInputDelay() const { return maxInputDelay_; }
+
  private:
   std::shared_ptr<CiderAllocator> allocator_;
   HashBuildTableSupplier hashBuildTableSupplier_;
   CrossBuildTableSupplier crossBuildTableSupplier_;
+  InterruptChecker interruptChecker_;
+  std::chrono::milliseconds timeLimit_{0};
+  int64_t maxOutputRows_{0};
+  int parallelism_{1};
+  int64_t morselSize_{65536};
+  int64_t minInputRows_{0};
+  int64_t minInputBytes_{0};
+  std::chrono::milliseconds maxInputDelay_{0};
 };
 
 using BatchProcessorContextPtr = std::shared_ptr<BatchProcessorContext>;
@@ -52,6 +52,61 @@ TEST_F(CiderAllocatorTest, ArenaAllocator) {
   allocator = nullptr;
 }
 
+TEST_F(CiderAllocatorTest, PoolAllocator) {
+  class CountingAllocator : public CiderAllocator {
+   public:
+    int8_t* allocate(size_t size) final {
+      ++allocations;
+      last_allocation_size = size;
+      return allocator_.allocate(size);
+    }
+    void deallocate(int8_t* p, size_t size) final {
+      ++deallocations;
+      allocator_.deallocate(p, size);
+    }
+
+    int allocations = 0;
+    int deallocations = 0;
+    size_t last_allocation_size = 0;
+
+   private:
+    std::allocator<int8_t> allocator_{};
+  };
+
+  auto parent = std::make_shared<CountingAllocator>();
+  {
+    auto allocator = std::make_shared<CiderPoolAllocator>(parent, 4096);
+    // Blocks of the same size class are recycled.
+    int8_t* ptr1 = allocator->allocate(1000);
+    allocator->deallocate(ptr1, 1000);
+    EXPECT_EQ(allocator->getPooledBytes(), 1024);
+    int8_t* ptr2 = allocator->allocate(800);
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_EQ(parent->allocations, 1);
+
+    // Growing within the size class keeps the block.
+    EXPECT_EQ(allocator->reallocate(ptr2, 800, 1024), ptr2);
+    int8_t* ptr3 = allocator->reallocate(ptr2, 1024, 2000);
+    EXPECT_EQ(parent->allocations, 2);
+    EXPECT_EQ(allocator->getPooledBytes(), 1024);
+
+    // Blocks beyond the pool capacity go back to parent.
+    int8_t* ptr4 = allocator->allocate(4096);
+    allocator->deallocate(ptr3, 2000);
+    allocator->deallocate(ptr4, 4096);
+    EXPECT_EQ(allocator->getPooledBytes(), 3072);
+    EXPECT_EQ(parent->deallocations, 1);
+
+    // Blocks larger than the pool are not rounded up.
+    int8_t* ptr5 = allocator->allocate(5000);
+    EXPECT_EQ(parent->last_allocation_size, 5000);
+    allocator->deallocate(ptr5, 5000);
+    EXPECT_EQ(allocator->getPooledBytes(), 3072);
+    EXPECT_EQ(parent->deallocations, 2);
+  }
+  EXPECT_EQ(parent->allocations, parent->deallocations);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
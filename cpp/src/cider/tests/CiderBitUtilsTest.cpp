@@ -23,6 +23,7 @@
 #include <glob.h>
 #include <gtest/gtest.h>
 #include "util/CiderBitUtils.h"
+#include "util/CiderCpuDispatch.h"
 
 #include <cstdint>
 #include <iostream>
@@ -146,6 +147,57 @@ TEST_F(CiderBitUtilsTest, CheckEqTest) {
   EXPECT_TRUE(CheckBitVectorEq(bv1, bv2, length));
 }
 
+TEST_F(CiderBitUtilsTest, CpuDispatchKernelsTest) {
+  using namespace CiderCpuDispatch;
+  const size_t bit_num = 1025;
+  CiderBitVector<> bit_vec_1(allocator, bit_num);
+  CiderBitVector<> bit_vec_2(allocator, bit_num);
+  auto bv1 = bit_vec_1.as<uint8_t>();
+  auto bv2 = bit_vec_2.as<uint8_t>();
+  for (size_t i = 0; i < bit_num; i += 3) {
+    setBitAt(bv1, i);
+  }
+  for (size_t i = 0; i < bit_num; i += 2) {
+    setBitAt(bv2, i);
+  }
+
+  const std::string str = "GET /index.html HTTP/1.1 Host: www.example.com";
+  const std::vector<std::string> patterns{"", "G", "HTTP", "example.com", "html ", "xyz"};
+
+  EXPECT_LE(getIsaLevel(), getHostIsaLevel());
+  auto& baseline = getKernels(IsaLevel::kBaseline);
+  for (auto level : {IsaLevel::kBaseline, IsaLevel::kAVX2, IsaLevel::kAVX512}) {
+    if (level > getHostIsaLevel()) {
+      continue;
+    }
+    auto& kernels = getKernels(level);
+    EXPECT_EQ(kernels.level, level);
+
+    EXPECT_EQ(kernels.count_set_bits(bv1, bit_num), 342ul);
+    EXPECT_EQ(kernels.count_set_bits(bv1, 100), countSetBits(bv1, 100));
+
+    CiderBitVector<> expected(allocator, bit_num);
+    CiderBitVector<> actual(allocator, bit_num);
+    baseline.bitwise_and(expected.as<uint8_t>(), bv1, bv2, bit_num);
+    kernels.bitwise_and(actual.as<uint8_t>(), bv1, bv2, bit_num);
+    EXPECT_TRUE(CheckBitVectorEq(expected.as<uint8_t>(), actual.as<uint8_t>(), bit_num));
+
+    for (auto& pattern : patterns) {
+      auto pos = str.find(pattern);
+      int64_t expected_pos = pos == std::string::npos ? -1 : pos;
+      EXPECT_EQ(kernels.find_str(str.data(), str.size(), pattern.data(), pattern.size()),
+                expected_pos)
+          << toString(level) << ", pattern: " << pattern;
+    }
+
+    std::string converted(str.size(), '\0');
+    kernels.ascii_lower(converted.data(), str.data(), str.size());
+    EXPECT_EQ(converted, "get /index.html http/1.1 host: www.example.com");
+    kernels.ascii_upper(converted.data(), str.data(), str.size());
+    EXPECT_EQ(converted, "GET /INDEX.HTML HTTP/1.1 HOST: WWW.EXAMPLE.COM");
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -0,0 +1,152 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "util/DateTimeParser.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+const std::vector<unsigned> kDims{0, 3, 6, 9};
+
+// Every string accepted by the fast path must parse to the same value as the general
+// parser.
+void checkTimestamp(const std::string& str) {
+  for (auto dim : kDims) {
+    auto fast = iso_datetime::parseTimestamp(str, dim);
+    ASSERT_TRUE(fast.has_value()) << str;
+    EXPECT_EQ(*fast, dateTimeParse<kTIMESTAMP>(str, dim)) << str << " dim " << dim;
+  }
+}
+
+void checkTime(const std::string& str) {
+  for (auto dim : kDims) {
+    auto fast = iso_datetime::parseTime(str, dim);
+    ASSERT_TRUE(fast.has_value()) << str;
+    EXPECT_EQ(*fast, dateTimeParse<kTIME>(str, dim)) << str << " dim " << dim;
+  }
+}
+
+void checkDate(const std::string& str) {
+  auto fast = iso_datetime::parseDateInDays(str);
+  ASSERT_TRUE(fast.has_value()) << str;
+  EXPECT_EQ(*fast, parseDateInDays(str)) << str;
+  EXPECT_EQ(*fast * kSecsPerDay, dateTimeParse<kDATE>(str, 0)) << str;
+}
+}  // namespace
+
+TEST(DateTimeParserTest, isoDateTest) {
+  checkDate("2023-01-31");
+  checkDate("1970-01-01");
+  checkDate("1969-12-31");
+  checkDate("1900-02-28");
+  checkDate("2000-02-29");
+  checkDate("0000-01-01");
+  checkDate("9999-12-31");
+  // Trailing characters are ignored by both parsers.
+  checkDate("2023-01-31 12:00:00");
+  checkDate("2023-01-311");
+
+  EXPECT_FALSE(iso_datetime::parseDateInDays(" 2023-01-31"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-1-31"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023/01/31"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-00-31"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-13-01"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-01-00"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-01-32"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("+023-01-31"));
+  EXPECT_FALSE(iso_datetime::parseDateInDays("2023-01-3"));
+}
+
+TEST(DateTimeParserTest, isoTimeTest) {
+  checkTime("00:00:00");
+  checkTime("12:00:00");
+  checkTime("23:59:59");
+  checkTime("23:59:60");
+  checkTime("23:59:61");
+  std::string fraction = "123456789";
+  for (size_t len = 1; len <= fraction.size(); ++len) {
+    checkTime("01:02:03." + fraction.substr(0, len));
+  }
+  checkTime("01:02:03.000000001");
+  checkTime("01:02:03.999999999");
+
+  // Leading spaces, a trailing '.' or timezone and more than 9 fraction digits are
+  // left to the general parser.
+  EXPECT_FALSE(iso_datetime::parseTime(" 01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03.", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03Z", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03+08:00", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03.5+08:00", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03.1234567890", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02:03.12a", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("T01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("1:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("24:00:00", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("12:60:00", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("12:00:62", 0));
+  EXPECT_FALSE(iso_datetime::parseTime("01:02 PM", 0));
+}
+
+TEST(DateTimeParserTest, isoTimestampTest) {
+  checkTimestamp("2023-01-31 01:02:03");
+  checkTimestamp("2023-01-31T01:02:03");
+  checkTimestamp("2023-01-31T12:00:00.5");
+  checkTimestamp("1970-01-01 00:00:00");
+  checkTimestamp("2016-12-31 23:59:60");
+  checkTimestamp("2016-12-31 23:59:61.999999999");
+  std::string fraction = "987654321";
+  for (size_t len = 1; len <= fraction.size(); ++len) {
+    checkTimestamp("2023-01-31 01:02:03." + fraction.substr(0, len));
+  }
+  // Negative epochs.
+  checkTimestamp("1969-12-31 23:59:59");
+  checkTimestamp("1969-12-31 23:59:59.5");
+  checkTimestamp("1900-01-01 00:00:00.000000001");
+  checkTimestamp("0000-01-01 00:00:00");
+  checkTimestamp("0000-03-01T12:34:56.789");
+
+  EXPECT_FALSE(iso_datetime::parseTimestamp(" 2023-01-31 01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31  01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31 01:02:03.", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31 01:02:03Z", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31 01:02:03+0800", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31 01:02:03.5 +08:00", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31 01:02", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("T2023-01-31 01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("2023-01-31:01:02:03", 0));
+  EXPECT_FALSE(iso_datetime::parseTimestamp("1675126923", 0));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    // LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
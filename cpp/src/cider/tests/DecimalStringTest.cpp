@@ -0,0 +1,188 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "util/DecimalString.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+int64_t parseInt64(const std::string& str) {
+  return decimal_string::parseInt64(str.data(), str.size());
+}
+
+// parseInt64 accepts what std::stoll accepts and returns the same value.
+void checkInt64(const std::string& str) {
+  EXPECT_EQ(parseInt64(str), std::stoll(str)) << str;
+}
+
+void checkFloat(const std::string& str) {
+  float result;
+  ASSERT_TRUE(decimal_string::parseSimpleFloat(str.data(), str.size(), result)) << str;
+  EXPECT_EQ(result, std::stof(str)) << str;
+  EXPECT_EQ(std::signbit(result), std::signbit(std::stof(str))) << str;
+}
+
+void checkDouble(const std::string& str) {
+  double result;
+  ASSERT_TRUE(decimal_string::parseSimpleDouble(str.data(), str.size(), result)) << str;
+  EXPECT_EQ(result, std::stod(str)) << str;
+  EXPECT_EQ(std::signbit(result), std::signbit(std::stod(str))) << str;
+}
+
+bool isSimpleFloat(const std::string& str) {
+  float result;
+  return decimal_string::parseSimpleFloat(str.data(), str.size(), result);
+}
+
+bool isSimpleDouble(const std::string& str) {
+  double result;
+  return decimal_string::parseSimpleDouble(str.data(), str.size(), result);
+}
+
+std::string formatInt64(int64_t value) {
+  char buf[24];
+  int32_t len = decimal_string::formatInt64(value, buf + sizeof(buf));
+  return std::string(buf + sizeof(buf) - len, len);
+}
+}  // namespace
+
+TEST(DecimalStringTest, parseInt64Test) {
+  checkInt64("0");
+  checkInt64("-0");
+  checkInt64("+7");
+  checkInt64("12345678");
+  checkInt64("123456789");
+  checkInt64("1234567890123456");
+  checkInt64("12345678901234567");
+  // 19 digits.
+  checkInt64("1234567890123456789");
+  checkInt64("-1234567890123456789");
+  checkInt64("9223372036854775807");
+  checkInt64("9223372036854775806");
+  checkInt64("-9223372036854775808");
+  checkInt64("-9223372036854775807");
+  // Leading zeros don't count as significant digits, also past 8 of them.
+  checkInt64("00000000012");
+  checkInt64("0000000000000000000000000009223372036854775807");
+  checkInt64("-000000000000000000009223372036854775808");
+  checkInt64("00000000000000000000");
+  // Leading whitespace and trailing characters.
+  checkInt64(" \t\n42");
+  checkInt64("  -42");
+  checkInt64("42abc");
+  checkInt64("12345678.9");
+  checkInt64("1234567/12345678");
+  checkInt64("12345678:");
+
+  // Out of range.
+  EXPECT_THROW(parseInt64("9223372036854775808"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("-9223372036854775809"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("9999999999999999999"), CiderRuntimeException);
+  // 20 digits.
+  EXPECT_THROW(parseInt64("12345678901234567890"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("-10000000000000000000"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("000123456789012345678901"), CiderRuntimeException);
+  // No digits.
+  EXPECT_THROW(parseInt64(""), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("   "), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("-"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("+"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64(" - 1"), CiderRuntimeException);
+  EXPECT_THROW(parseInt64("abc"), CiderRuntimeException);
+}
+
+TEST(DecimalStringTest, parseSimpleDecimalTest) {
+  std::vector<std::string> inputs{"0",
+                                  "-0",
+                                  "+1",
+                                  "1.",
+                                  ".5",
+                                  "-.5",
+                                  "0.1",
+                                  "3.14159",
+                                  "-2.5",
+                                  "12345.678",
+                                  "0.0000000001",
+                                  "16777216",
+                                  "1677721.6"};
+  for (auto& str : inputs) {
+    checkFloat(str);
+    checkDouble(str);
+  }
+  checkDouble("9007199254740992");
+  checkDouble("900719925474.0992");
+  checkDouble(".0000000000000000001");
+  checkDouble("-12345678.90123456");
+
+  // Mantissas that are not exact fall back to the standard library.
+  EXPECT_FALSE(isSimpleFloat("16777217"));
+  EXPECT_FALSE(isSimpleFloat("1677721.7"));
+  EXPECT_FALSE(isSimpleDouble("9007199254740993"));
+  EXPECT_FALSE(isSimpleDouble("12345678901234567890"));
+  EXPECT_FALSE(isSimpleDouble("0.0000000000000000001"));
+  // And so do scales beyond exact powers of ten.
+  EXPECT_FALSE(isSimpleFloat("0.00000000001"));
+  EXPECT_FALSE(isSimpleDouble("0.00000000000000000000001"));
+  // And any other format.
+  for (std::string str :
+       {"", " ", "-", "+", ".", "-.", " 1", "1 ", "1.2.3", "1e5", "0x10", "inf", "nan"}) {
+    EXPECT_FALSE(isSimpleFloat(str)) << str;
+    EXPECT_FALSE(isSimpleDouble(str)) << str;
+  }
+}
+
+TEST(DecimalStringTest, formatInt64Test) {
+  std::vector<int64_t> values{0,
+                              1,
+                              -1,
+                              9,
+                              10,
+                              -10,
+                              99,
+                              100,
+                              12345,
+                              -123456,
+                              1000000000000000000,
+                              std::numeric_limits<int64_t>::max(),
+                              std::numeric_limits<int64_t>::max() - 1,
+                              std::numeric_limits<int64_t>::min(),
+                              std::numeric_limits<int64_t>::min() + 1};
+  for (auto value : values) {
+    EXPECT_EQ(formatInt64(value), std::to_string(value));
+  }
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    // LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
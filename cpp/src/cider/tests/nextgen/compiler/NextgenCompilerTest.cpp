@@ -123,6 +123,58 @@ TEST_F(NextgenCompilerTest, FrameworkTest2) {
   executeTest("select a + b, a - b from test", 10);
 }
 
+TEST_F(NextgenCompilerTest, VectorizeWithInterruptCheckTest) {
+  auto json = RunIsthmus::processSql("select a + b, a - b from test",
+                                     "CREATE TABLE test(a BIGINT, b BIGINT NOT NULL);");
+  ::substrait::Plan plan;
+  google::protobuf::util::JsonStringToMessage(json, &plan);
+  generator::SubstraitToRelAlgExecutionUnit substrait2eu(plan);
+  auto eu = substrait2eu.createRelAlgExecutionUnit();
+
+  auto get_vectorized_loop_num = [&eu](const context::CodegenOptions& codegen_co) {
+    auto codegen_ctx = compile(eu, codegen_co);
+    auto& module = codegen_ctx->getJITModule();
+    return dynamic_cast<cider::jitlib::LLVMJITModule&>(*module).getVectorizedLoopNum();
+  };
+
+  context::CodegenOptions codegen_co;
+  codegen_co.enable_vectorize = true;
+  codegen_co.co.enable_vectorize = true;
+  ASSERT_GT(codegen_co.interrupt_check_interval, 0);
+  auto polled_loop_num = get_vectorized_loop_num(codegen_co);
+
+  // Interruption is polled between chunks of rows, so the row loops of the vectorized
+  // project are vectorized the same as without polling.
+  codegen_co.interrupt_check_interval = 0;
+  EXPECT_EQ(polled_loop_num, get_vectorized_loop_num(codegen_co));
+
+  codegen_co.enable_vectorize = false;
+  codegen_co.co.enable_vectorize = false;
+  codegen_co.interrupt_check_interval = 65536;
+  EXPECT_GT(polled_loop_num, get_vectorized_loop_num(codegen_co));
+}
+
+TEST_F(NextgenCompilerTest, VectorizeDateExtractTest) {
+  auto json = RunIsthmus::processSql("select extract(year from d) from test",
+                                     "CREATE TABLE test(d DATE);");
+  ::substrait::Plan plan;
+  google::protobuf::util::JsonStringToMessage(json, &plan);
+  generator::SubstraitToRelAlgExecutionUnit substrait2eu(plan);
+  auto eu = substrait2eu.createRelAlgExecutionUnit();
+
+  auto get_vectorized_loop_num = [&eu](bool enable_vectorize) {
+    context::CodegenOptions codegen_co;
+    codegen_co.enable_vectorize = enable_vectorize;
+    codegen_co.co.enable_vectorize = enable_vectorize;
+    auto codegen_ctx = compile(eu, codegen_co);
+    auto& module = codegen_ctx->getJITModule();
+    return dynamic_cast<cider::jitlib::LLVMJITModule&>(*module).getVectorizedLoopNum();
+  };
+
+  // The year extraction inlines into the vectorized project and its row loop vectorizes.
+  EXPECT_GT(get_vectorized_loop_num(true), get_vectorized_loop_num(false));
+}
+
 class CiderNextgenCompilerTestBase : public CiderNextgenTestBase {
  public:
   CiderNextgenCompilerTestBase() {
@@ -148,6 +200,15 @@ TEST_F(CiderNextgenCompilerTestBase, noGroupbyTest) {
   assertQuery("SELECT SUM(col_1), SUM(col_2) FROM test WHERE col_1 <= col_2");
 }
 
+TEST_F(CiderNextgenCompilerTestBase, selectionVectorFilterTest) {
+  context::CodegenOptions codegen_options{};
+  codegen_options.enable_vectorize = true;
+  setCodegenOptions(codegen_options);
+  assertQuery("SELECT col_1 + col_2, col_3 FROM test WHERE col_1 <= col_2");
+  assertQuery("SELECT col_3 FROM test WHERE col_1 < col_2 AND col_2 < col_3");
+  assertQuery("SELECT SUM(col_1), SUM(col_2) FROM test WHERE col_1 <= col_2");
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -251,6 +251,19 @@ TEST_F(DateRandomAndNullQueryTest, DateAddOnColumnTest) {
       "date '1971-02-01' ");
 }
 
+TEST_F(DateRandomAndNullQueryTest, VectorizedDateTest) {
+  context::CodegenOptions codegen_options{};
+  codegen_options.enable_vectorize = true;
+  setCodegenOptions(codegen_options);
+  assertQuery(
+      "SELECT extract(year from col_b), extract(month from col_b), extract(day from "
+      "col_b) FROM test");
+  assertQuery("SELECT extract(quarter from col_b) FROM test", "extract/quarter.json");
+  assertQuery("SELECT extract(doy from col_b) FROM test", "extract/day_of_year.json");
+  assertQuery("SELECT col_a + interval '10' day + interval '1' month FROM test");
+  assertQuery("SELECT col_b + interval '1' year, extract(day from col_a) FROM test");
+}
+
 TEST_F(DateRandomAndNullQueryTest, DateOpTest) {
   assertQuery("SELECT * FROM test where extract(day from col_b) > 15");
 
@@ -157,6 +157,21 @@ TEST_F(CiderFilterRandomTestNG, inTest) {
   assertQueryIgnoreOrder("SELECT * FROM test WHERE col_1 in (24, 25, 26) and col_2 > 20");
   assertQueryIgnoreOrder(
       "SELECT * FROM test WHERE col_1 in (24 * 2 + 2, (25 + 2) * 10, 26)");
+  // Runs of consecutive values, dense lists and sparse lists.
+  assertQuery("SELECT col_1 FROM test WHERE col_1 in (1, 2, 3, 4, 5, 6, 10, 11, 12, 20)");
+  assertQuery(
+      "SELECT col_2 FROM test WHERE col_2 not in (1, 3, 5, 7, 9, 11, 13, 15, 17, 19, "
+      "21)");
+  assertQuery(
+      "SELECT col_3 FROM test WHERE col_3 in (-100, -60, -20, 0, 20, 40, 60, 80, 100, "
+      "120)");
+  assertQuery(
+      "SELECT col_2 FROM test WHERE col_2 in (-1000000000, -100000, 1, 100000, 2000000, "
+      "30000000, 400000000, 5000000000, 60000000000)");
+  // The span of the values exceeds int64_t.
+  assertQuery(
+      "SELECT col_2 FROM test WHERE col_2 in (-9223372036854775807, -100000, 1, 3, 5, "
+      "7, 9, 11, 100000, 9223372036854775807)");
 }
 
 TEST_F(CiderFilterSequenceTestNG, integerFilterTest) {
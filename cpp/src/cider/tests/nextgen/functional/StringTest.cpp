@@ -51,6 +51,10 @@ using namespace cider::exec::nextgen;
     ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '22%22'");                      \
     ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '_33%'");                       \
     ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '44_%'");                       \
+    ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '1%2%3'");                      \
+    ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '%1_1%2%'");                    \
+    ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '%2_2_'");                      \
+    ASSERT_FUNC("SELECT col_2 FROM test where col_2 LIKE '__________'");                 \
     ASSERT_FUNC(                                                                         \
         "SELECT col_2 FROM test where col_2 LIKE '5555%' OR col_2 LIKE '%6666'");        \
     ASSERT_FUNC(                                                                         \
@@ -90,6 +94,16 @@ using namespace cider::exec::nextgen;
         "SELECT * FROM test WHERE col_1 >= 0 and SUBSTRING(col_2, 1, 4) IN "            \
         "('0000', '1111', '2222', '3333')",                                             \
         "in_string_nest_with_binop.json");                                              \
+    ASSERT_FUNC(                                                                        \
+        "SELECT * FROM test WHERE col_2 IN ('0000000000', '11111', '2222222222', "      \
+        "'333333333333')");                                                             \
+    ASSERT_FUNC(                                                                        \
+        "SELECT * FROM test WHERE col_2 IN ('0000000000', '1111111111', '2222222222', " \
+        "'3333333333', '4444444444', '5555555555', '66666', '777777777777', '', "       \
+        "'9999999999')");                                                               \
+    ASSERT_FUNC(                                                                        \
+        "SELECT * FROM test WHERE SUBSTRING(col_2, 1, 4) NOT IN ('0000', '1111', "      \
+        "'2222', '3333', '4444', '5555', '6666', '7777', '8888')");                     \
   }
 
 #define BASIC_STRING_TEST_UNIT_ARROW(TEST_CLASS, UNIT_NAME) \
@@ -465,6 +479,18 @@ TEST_F(CiderStringNullableTestNextGen, CharLengthTest) {
       "stringop_charlen_nested_null.json");
 }
 
+// Expensive conjuncts are reordered behind cheap ones and short-circuited.
+TEST_F(CiderStringNullableTestNextGen, ShortCircuitConjunctTest) {
+  assertQuery("SELECT col_1, col_2 FROM test WHERE col_2 LIKE '%1%' AND col_1 < 20");
+  assertQuery(
+      "SELECT col_1 FROM test WHERE SUBSTRING(col_2, 1, 2) = '11' AND col_1 > 5 AND "
+      "col_1 < 40");
+  assertQuery(
+      "SELECT col_1 FROM test WHERE col_2 NOT LIKE '%2%' AND (col_1 > 5 AND col_2 "
+      "LIKE '1%')");
+  assertQuery("SELECT col_1 FROM test WHERE col_2 LIKE '%3%' AND col_1 IS NULL");
+}
+
 // stringop: trim
 
 class CiderTrimOpTestNextGen : public CiderNextgenTestBase {
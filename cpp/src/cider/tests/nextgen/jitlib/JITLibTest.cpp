@@ -333,6 +333,77 @@ TEST_F(JITLibTests, ExternalModuleTest) {
   EXPECT_EQ(ptr(), 999);
 }
 
+TEST_F(JITLibTests, InliningReportTest) {
+  CompilationOptions co;
+  co.report_inlining = true;
+  LLVMJITModule module("TestModule", true, co);
+  JITFunctionPointer func =
+      JITFunctionBuilder()
+          .setFuncName("test_func")
+          .registerModule(module)
+          .addReturn(JITTypeTag::INT32)
+          .addProcedureBuilder([](JITFunctionPointer function) {
+            JITValuePointer a = function->createLiteral(JITTypeTag::INT32, 123);
+            JITValuePointer b = function->createLiteral(JITTypeTag::INT32, 876);
+            auto x = function->emitRuntimeFunctionCall(
+                "external_call_test_sum",
+                JITFunctionEmitDescriptor{.ret_type = JITTypeTag::INT32,
+                                          .params_vector = {a.get(), b.get()}});
+            function->emitRuntimeFunctionCall(
+                "test_to_string",
+                JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                          .params_vector = {x.get()}});
+            function->createReturn(*x);
+          })
+          .build();
+  module.finish();
+
+  auto& report = module.getInliningReport();
+  EXPECT_EQ(report.inlined, std::vector<std::string>{"external_call_test_sum"});
+  EXPECT_TRUE(report.removed.empty());
+  EXPECT_EQ(report.called, std::vector<std::string>{"test_to_string"});
+
+  auto ptr = func->getFunctionPointer<int32_t>();
+  EXPECT_EQ(ptr(), 999);
+}
+
+TEST_F(JITLibTests, InliningReportRemovedCallTest) {
+  CompilationOptions co;
+  co.report_inlining = true;
+  LLVMJITModule module("TestModule", true, co);
+  JITFunctionPointer func =
+      JITFunctionBuilder()
+          .setFuncName("test_func")
+          .registerModule(module)
+          .addReturn(JITTypeTag::INT32)
+          .addProcedureBuilder([](JITFunctionPointer function) {
+            JITValuePointer a = function->createLiteral(JITTypeTag::INT32, 123);
+            // The call in a never taken branch is removed, not inlined.
+            function->createIfBuilder()
+                ->condition([&]() {
+                  return function->createLiteral(JITTypeTag::BOOL, false);
+                })
+                ->ifTrue([&]() {
+                  function->emitRuntimeFunctionCall(
+                      "test_to_string",
+                      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::VOID,
+                                                .params_vector = {a.get()}});
+                })
+                ->build();
+            function->createReturn(*a);
+          })
+          .build();
+  module.finish();
+
+  auto& report = module.getInliningReport();
+  EXPECT_TRUE(report.inlined.empty());
+  EXPECT_EQ(report.removed, std::vector<std::string>{"test_to_string"});
+  EXPECT_TRUE(report.called.empty());
+
+  auto ptr = func->getFunctionPointer<int32_t>();
+  EXPECT_EQ(ptr(), 123);
+}
+
 TEST_F(JITLibTests, BasicIFControlFlowWithoutElseTest) {
   LLVMJITModule module("TestModule");
   JITFunctionPointer func = JITFunctionBuilder()
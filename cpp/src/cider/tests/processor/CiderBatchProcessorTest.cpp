@@ -21,8 +21,12 @@
 
 #include <google/protobuf/util/json_util.h>
 #include <gtest/gtest.h>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <utility>
 
+#include "cider/CiderException.h"
 #include "exec/processor/StatefulProcessor.h"
 #include "exec/processor/StatelessProcessor.h"
 #include "tests/utils/QueryArrowDataGenerator.h"
@@ -32,14 +36,19 @@ using namespace cider::exec::processor;
 
 namespace {
 
-std::shared_ptr<BatchProcessor> createBatchProcessorFromSql(const std::string& sql,
-                                                            const std::string& ddl) {
+std::shared_ptr<BatchProcessor> createBatchProcessorFromSql(
+    const std::string& sql,
+    const std::string& ddl,
+    BatchProcessorContextPtr context = nullptr,
+    const cider::exec::nextgen::context::CodegenOptions& codegen_options = {}) {
   std::string json = RunIsthmus::processSql(sql, ddl);
   ::substrait::Plan plan;
   google::protobuf::util::JsonStringToMessage(json, &plan);
-  auto allocator = std::make_shared<CiderDefaultAllocator>();
-  auto context = std::make_shared<BatchProcessorContext>(allocator);
-  auto processor = makeBatchProcessor(plan, context);
+  if (!context) {
+    auto allocator = std::make_shared<CiderDefaultAllocator>();
+    context = std::make_shared<BatchProcessorContext>(allocator);
+  }
+  auto processor = makeBatchProcessor(plan, context, codegen_options);
   return processor;
 }
 
@@ -120,6 +129,696 @@ TEST(CiderBatchProcessorTest, statefulProcessorProcessNextBatchTest) {
   EXPECT_EQ(*(int32_t*)(output_array.children[1]->buffers[1]), 1293 * 2);
 }
 
+TEST(CiderBatchProcessorTest, cancelTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT NOT NULL);
+        )";
+  std::string sql = "SELECT col_1 + col_2 FROM test WHERE col_1 <= col_2";
+  auto processor = createBatchProcessorFromSql(sql, ddl);
+
+  struct ArrowArray* input_array;
+  struct ArrowSchema* input_schema;
+  QueryArrowDataGenerator::generateBatchByTypes(
+      input_schema,
+      input_array,
+      10,
+      {"col_1", "col_2"},
+      {CREATE_SUBSTRAIT_TYPE(I64), CREATE_SUBSTRAIT_TYPE(I64)});
+
+  processor->cancel();
+  EXPECT_THROW(processor->processNextBatch(input_array, input_schema),
+               CiderRuntimeException);
+}
+
+TEST(CiderBatchProcessorTest, interruptInGeneratedLoopTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT NOT NULL);
+        )";
+  std::string sql = "SELECT col_1 + col_2 FROM test WHERE col_1 <= col_2";
+
+  // Allows the check ahead of the batch, then interrupts at the first poll of the
+  // generated loop.
+  int check_times = 0;
+  auto context =
+      std::make_shared<BatchProcessorContext>(std::make_shared<CiderDefaultAllocator>());
+  context->setInterruptChecker([&check_times]() { return ++check_times > 1; });
+  auto processor = createBatchProcessorFromSql(sql, ddl, context);
+
+  struct ArrowArray* input_array;
+  struct ArrowSchema* input_schema;
+  QueryArrowDataGenerator::generateBatchByTypes(
+      input_schema,
+      input_array,
+      200000,
+      {"col_1", "col_2"},
+      {CREATE_SUBSTRAIT_TYPE(I64), CREATE_SUBSTRAIT_TYPE(I64)});
+
+  try {
+    processor->processNextBatch(input_array, input_schema);
+    FAIL() << "processNextBatch should be interrupted.";
+  } catch (const CiderRuntimeException& e) {
+    EXPECT_NE(std::string(e.what()).find("interrupted"), std::string::npos);
+  }
+  EXPECT_EQ(check_times, 2);
+}
+
+TEST(CiderBatchProcessorTest, timeLimitTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT NOT NULL);
+        )";
+  std::string sql = "SELECT col_1 + col_2 FROM test WHERE col_1 <= col_2";
+
+  // Sleeps at the first poll of the generated loop to exceed the time limit.
+  int check_times = 0;
+  auto context =
+      std::make_shared<BatchProcessorContext>(std::make_shared<CiderDefaultAllocator>());
+  context->setTimeLimit(std::chrono::milliseconds(10));
+  context->setInterruptChecker([&check_times]() {
+    if (++check_times == 2) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+  });
+  auto processor = createBatchProcessorFromSql(sql, ddl, context);
+
+  struct ArrowArray* input_array;
+  struct ArrowSchema* input_schema;
+  QueryArrowDataGenerator::generateBatchByTypes(
+      input_schema,
+      input_array,
+      200000,
+      {"col_1", "col_2"},
+      {CREATE_SUBSTRAIT_TYPE(I64), CREATE_SUBSTRAIT_TYPE(I64)});
+
+  try {
+    processor->processNextBatch(input_array, input_schema);
+    FAIL() << "processNextBatch should exceed the time limit.";
+  } catch (const CiderRuntimeException& e) {
+    EXPECT_NE(std::string(e.what()).find("time limit"), std::string::npos);
+  }
+}
+
+TEST(CiderBatchProcessorTest, runtimeProfileRecompileTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT, col_2 BIGINT NOT NULL);
+        )";
+  std::string sql = "SELECT col_1 + col_2 FROM test WHERE col_1 <= col_2";
+
+  cider::exec::nextgen::context::CodegenOptions codegen_options;
+  codegen_options.enable_runtime_profile = true;
+  codegen_options.profile_batch_num = 2;
+  auto processor = createBatchProcessorFromSql(sql, ddl, nullptr, codegen_options);
+
+  auto input_builder = ArrowArrayBuilder();
+  auto&& [input_schema, input_array] =
+      input_builder.setRowNum(10)
+          .addColumn<int64_t>(
+              "col_1",
+              CREATE_SUBSTRAIT_TYPE(I64),
+              {1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+              {true, true, false, false, false, false, false, false, false, false})
+          .addColumn<int64_t>(
+              "col_2", CREATE_SUBSTRAIT_TYPE(I64), {5, 5, 5, 5, 5, 5, 5, 5, 5, 5})
+          .build();
+  input_array->release = nullptr;
+  input_schema->release = nullptr;
+
+  // The first two batches run instrumented code, the third one runs recompiled code.
+  for (int i = 0; i < 3; ++i) {
+    processor->processNextBatch(input_array, input_schema);
+    if (i == 1) {
+      auto profile =
+          std::dynamic_pointer_cast<DefaultBatchProcessor>(processor)->getRuntimeProfile();
+      ASSERT_EQ(profile.filter_selectivity.size(), 1);
+      EXPECT_DOUBLE_EQ(profile.filter_selectivity[0].second, 0.3);
+      // Conjuncts are keyed by their position in the filter.
+      ASSERT_EQ(profile.conjunct_selectivity.size(), 1);
+      EXPECT_EQ(profile.conjunct_selectivity[0].first, "filter_0.conjunct_0");
+      EXPECT_DOUBLE_EQ(profile.conjunct_selectivity[0].second, 0.3);
+      ASSERT_EQ(profile.null_rate.size(), 1);
+      EXPECT_DOUBLE_EQ(profile.null_rate[0].second, 0.2);
+    }
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 3);
+    auto values = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    EXPECT_EQ(values[0], 8);
+    EXPECT_EQ(values[1], 9);
+    EXPECT_EQ(values[2], 10);
+  }
+
+  // The recompiled context shares the interrupt flag of the processor.
+  processor->cancel();
+  EXPECT_THROW(processor->processNextBatch(input_array, input_schema),
+               CiderRuntimeException);
+}
+
+TEST(CiderBatchProcessorTest, passThroughColumnTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT, col_2 BIGINT NOT NULL);
+        )";
+
+  auto build_input = []() {
+    return ArrowArrayBuilder()
+        .setRowNum(5)
+        .addColumn<int64_t>("col_1",
+                            CREATE_SUBSTRAIT_TYPE(I64),
+                            {1, 2, 3, 4, 5},
+                            {false, true, false, false, false})
+        .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {1, 2, 3, 4, 5})
+        .build();
+  };
+
+  {
+    // Unfiltered input column shares buffers with the input batch, which is released
+    // together with the output batch.
+    auto processor =
+        createBatchProcessorFromSql("SELECT col_1, col_1 + col_2 FROM test", ddl);
+    auto&& [input_schema, input_array] = build_input();
+    auto input_values = input_array->children[0]->buffers[1];
+    processor->processNextBatch(input_array, input_schema);
+    EXPECT_EQ(input_array->release, nullptr);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 5);
+    EXPECT_EQ(output_array.children[0]->buffers[1], input_values);
+    EXPECT_EQ(output_array.children[0]->null_count, 1);
+    auto sums = reinterpret_cast<const int64_t*>(output_array.children[1]->buffers[1]);
+    EXPECT_EQ(sums[4], 10);
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+
+  {
+    // Rows selected by a vectorized filter are gathered.
+    cider::exec::nextgen::context::CodegenOptions codegen_options;
+    codegen_options.enable_vectorize = true;
+    auto processor = createBatchProcessorFromSql(
+        "SELECT col_1 FROM test WHERE col_2 > 2", ddl, nullptr, codegen_options);
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 3);
+    auto values = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[1], 4);
+    EXPECT_EQ(values[2], 5);
+    EXPECT_EQ(output_array.children[0]->null_count, 0);
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+}
+
+TEST(CiderBatchProcessorTest, dictionaryEncodedInputTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 VARCHAR, col_2 BIGINT NOT NULL);
+        )";
+  auto build_input = []() {
+    return ArrowArrayBuilder()
+        .setRowNum(6)
+        .addDictionaryUTF8Column("col_1",
+                                 "aaabbc",
+                                 {0, 3, 5, 6},
+                                 {2, 0, 1, 0, 0, 1},
+                                 {false, false, true, false, false, false})
+        .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {1, 2, 3, 4, 5, 6})
+        .build();
+  };
+
+  auto check_strings = [](const ArrowArray* array,
+                          const std::vector<std::string>& expected) {
+    ASSERT_EQ(array->length, expected.size());
+    auto offsets = reinterpret_cast<const int32_t*>(array->buffers[1]);
+    auto data = reinterpret_cast<const char*>(array->buffers[2]);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(std::string(data + offsets[i], offsets[i + 1] - offsets[i]),
+                expected[i]);
+    }
+  };
+
+  {
+    // Rows are decoded through the dictionary by generated code.
+    auto processor =
+        createBatchProcessorFromSql("SELECT col_2 FROM test WHERE col_1 = 'aaa'", ddl);
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 3);
+    auto values = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    EXPECT_EQ(values[0], 2);
+    EXPECT_EQ(values[1], 4);
+    EXPECT_EQ(values[2], 5);
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+
+  {
+    // Passthrough output of a dictionary-encoded column is flat.
+    auto processor = createBatchProcessorFromSql("SELECT col_1 FROM test", ddl);
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    EXPECT_EQ(output_array.children[0]->dictionary, nullptr);
+    EXPECT_EQ(output_array.children[0]->null_count, 1);
+    check_strings(output_array.children[0], {"c", "aaa", "bb", "aaa", "aaa", "bb"});
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+}
+
+TEST(CiderBatchProcessorTest, dictionaryPredicateTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 VARCHAR, col_2 BIGINT NOT NULL);
+        )";
+  auto check_output = [](BatchProcessor& processor,
+                         const std::vector<int64_t>& expected) {
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor.getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, expected.size());
+    auto values = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(values[i], expected[i]);
+    }
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  };
+
+  // Predicates are evaluated per dictionary entry, the second batch has another
+  // dictionary. Dictionaries have an empty entry.
+  auto test_batches = [&](const std::string& sql,
+                          const std::vector<int64_t>& expected_1,
+                          const std::vector<int64_t>& expected_2) {
+    auto processor = createBatchProcessorFromSql(sql, ddl);
+    auto&& [schema_1, array_1] =
+        ArrowArrayBuilder()
+            .setRowNum(6)
+            .addDictionaryUTF8Column("col_1",
+                                     "applebananaapricot",
+                                     {0, 5, 11, 11, 18},
+                                     {2, 0, 1, 3, 0, 2},
+                                     {false, false, true, false, false, false})
+            .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {1, 2, 3, 4, 5, 6})
+            .build();
+    processor->processNextBatch(array_1, schema_1);
+    check_output(*processor, expected_1);
+
+    auto&& [schema_2, array_2] =
+        ArrowArrayBuilder()
+            .setRowNum(4)
+            .addDictionaryUTF8Column(
+                "col_1", "avocadocherry", {0, 0, 7, 13}, {1, 2, 0, 1})
+            .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {7, 8, 9, 10})
+            .build();
+    processor->processNextBatch(array_2, schema_2);
+    check_output(*processor, expected_2);
+  };
+
+  test_batches("SELECT col_2 FROM test WHERE col_1 LIKE 'a%'", {2, 4, 5}, {7, 10});
+  test_batches("SELECT col_2 FROM test WHERE col_1 NOT LIKE '%an%'",
+               {1, 2, 4, 5, 6},
+               {7, 8, 9, 10});
+  test_batches("SELECT col_2 FROM test WHERE 'b' > col_1", {1, 2, 4, 5, 6}, {7, 9, 10});
+  test_batches("SELECT col_2 FROM test WHERE col_1 <> ''", {2, 4, 5}, {7, 8, 10});
+}
+
+TEST(CiderBatchProcessorTest, dictionaryPredicateCacheTest) {
+  using cider::exec::nextgen::context::CodegenContext;
+  int evaluations = 0;
+  auto predicates = std::make_shared<std::vector<CodegenContext::StringPredicate>>();
+  predicates->emplace_back([&evaluations](std::string_view str) {
+    ++evaluations;
+    return str.size() > 5;
+  });
+  cider::exec::nextgen::context::RuntimeContext runtime_context(0);
+  runtime_context.setDictionaryPredicates(predicates);
+
+  auto build_batch = [](const std::string& dict_data,
+                        const std::vector<int32_t>& dict_offsets) {
+    ArrowArrayBuilder builder;
+    auto&& [schema, array] =
+        builder.setRowNum(2)
+            .addDictionaryUTF8Column("col_1", dict_data, dict_offsets, {0, 1})
+            .build();
+    return std::pair{schema, array};
+  };
+
+  // The empty string and both entries are evaluated.
+  auto&& [schema_1, array_1] = build_batch("applebanana", {0, 5, 11});
+  auto results = runtime_context.getDictionaryPredicateResults(array_1->children[0], 0);
+  ASSERT_NE(results, nullptr);
+  EXPECT_EQ(evaluations, 3);
+  EXPECT_FALSE(results[0]);
+  EXPECT_FALSE(results[1]);
+  EXPECT_TRUE(results[6]);
+
+  // Results are reused for the same dictionary buffers.
+  EXPECT_EQ(runtime_context.getDictionaryPredicateResults(array_1->children[0], 0),
+            results);
+  EXPECT_EQ(evaluations, 3);
+
+  // And for an equal dictionary in other buffers.
+  auto&& [schema_2, array_2] = build_batch("applebanana", {0, 5, 11});
+  EXPECT_EQ(runtime_context.getDictionaryPredicateResults(array_2->children[0], 0),
+            results);
+  EXPECT_EQ(evaluations, 3);
+
+  // Another dictionary is evaluated again.
+  auto&& [schema_3, array_3] = build_batch("cherryfig", {0, 6, 9});
+  results = runtime_context.getDictionaryPredicateResults(array_3->children[0], 0);
+  EXPECT_EQ(evaluations, 6);
+  EXPECT_TRUE(results[1]);
+  EXPECT_FALSE(results[7]);
+
+  array_1->release(array_1);
+  schema_1->release(schema_1);
+  array_2->release(array_2);
+  schema_2->release(schema_2);
+  array_3->release(array_3);
+  schema_3->release(schema_3);
+}
+
+TEST(CiderBatchProcessorTest, stringViewOutputTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 VARCHAR, col_2 BIGINT NOT NULL);
+        )";
+  cider::exec::nextgen::context::CodegenOptions codegen_options;
+  codegen_options.string_view_output = true;
+  auto processor = createBatchProcessorFromSql(
+      "SELECT col_1 FROM test WHERE col_2 > 1", ddl, nullptr, codegen_options);
+
+  std::string long_str_1 = "a string longer than 12 bytes";
+  std::string long_str_2 = "another long string";
+  auto&& [input_schema, input_array] =
+      ArrowArrayBuilder()
+          .setRowNum(5)
+          .addUTF8Column("col_1",
+                         "skipped" + long_str_1 + "short" + long_str_2,
+                         {0, 7, 36, 36, 41, 60},
+                         {false, false, true, false, false})
+          .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {1, 2, 3, 4, 5})
+          .build();
+  processor->processNextBatch(input_array, input_schema);
+
+  struct ArrowArray output_array;
+  struct ArrowSchema output_schema;
+  processor->getResult(output_array, output_schema);
+  ASSERT_EQ(output_array.length, 4);
+  EXPECT_STREQ(output_schema.children[0]->format, "vu");
+  auto column = output_array.children[0];
+  EXPECT_EQ(column->n_buffers, 4);
+  EXPECT_EQ(column->null_count, 1);
+  EXPECT_EQ(CiderBatchUtils::extractUtf8ArrowArrayAt(column, 0), long_str_1);
+  EXPECT_EQ(CiderBatchUtils::extractUtf8ArrowArrayAt(column, 2), "short");
+  EXPECT_EQ(CiderBatchUtils::extractUtf8ArrowArrayAt(column, 3), long_str_2);
+  // Only long strings are kept in the data buffer.
+  EXPECT_EQ(*reinterpret_cast<const int64_t*>(column->buffers[3]),
+            long_str_1.size() + long_str_2.size());
+  output_array.release(&output_array);
+  output_schema.release(&output_schema);
+
+  // The data and sizes buffers exist even if all strings are inlined.
+  auto&& [short_schema, short_array] =
+      ArrowArrayBuilder()
+          .setRowNum(2)
+          .addUTF8Column("col_1", "ab", {0, 1, 2})
+          .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), {2, 3})
+          .build();
+  processor->processNextBatch(short_array, short_schema);
+  processor->getResult(output_array, output_schema);
+  ASSERT_EQ(output_array.length, 2);
+  column = output_array.children[0];
+  ASSERT_NE(column->buffers[2], nullptr);
+  ASSERT_NE(column->buffers[3], nullptr);
+  EXPECT_EQ(*reinterpret_cast<const int64_t*>(column->buffers[3]), 0);
+  EXPECT_EQ(CiderBatchUtils::extractUtf8ArrowArrayAt(column, 1), "b");
+  output_array.release(&output_array);
+  output_schema.release(&output_schema);
+}
+
+TEST(CiderBatchProcessorTest, stringViewInputTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 VARCHAR);
+        )";
+  auto processor = createBatchProcessorFromSql("SELECT col_1 FROM test", ddl);
+  auto&& [input_schema, input_array] = ArrowArrayBuilder()
+                                           .setRowNum(2)
+                                           .addUTF8Column("col_1", "ab", {0, 1, 2})
+                                           .build();
+  // Views would be read as offsets.
+  input_schema->children[0]->format = "vu";
+  EXPECT_THROW(processor->processNextBatch(input_array, input_schema),
+               CiderUnsupportedException);
+}
+
+TEST(CiderBatchProcessorTest, constantAndRunEndEncodedInputTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT, col_3 BIGINT NOT NULL);
+        )";
+  auto build_input = []() {
+    return ArrowArrayBuilder()
+        .setRowNum(6)
+        .addConstantColumn<int64_t>("col_1", CREATE_SUBSTRAIT_TYPE(I64), 10)
+        .addRunEndEncodedColumn<int64_t>("col_2",
+                                         CREATE_SUBSTRAIT_TYPE(I64),
+                                         {2, 5, 6},
+                                         {1, 2, 3},
+                                         {false, true, false})
+        .addColumn<int64_t>("col_3", CREATE_SUBSTRAIT_TYPE(I64), {1, 2, 3, 4, 5, 6})
+        .build();
+  };
+
+  {
+    // Rows are mapped to constant values and runs by generated code.
+    auto processor = createBatchProcessorFromSql(
+        "SELECT col_3, col_1 + col_2 FROM test WHERE col_1 + col_2 > 10", ddl);
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 3);
+    auto col_3 = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    auto sum = reinterpret_cast<const int64_t*>(output_array.children[1]->buffers[1]);
+    EXPECT_EQ(col_3[0], 1);
+    EXPECT_EQ(col_3[1], 2);
+    EXPECT_EQ(col_3[2], 6);
+    EXPECT_EQ(sum[0], 11);
+    EXPECT_EQ(sum[1], 11);
+    EXPECT_EQ(sum[2], 13);
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+
+  {
+    // Passthrough output of encoded columns is flat.
+    auto processor = createBatchProcessorFromSql("SELECT col_1, col_2 FROM test", ddl);
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, 6);
+    auto col_1 = output_array.children[0];
+    auto col_2 = output_array.children[1];
+    ASSERT_EQ(col_1->length, 6);
+    ASSERT_EQ(col_2->length, 6);
+    auto col_1_values = reinterpret_cast<const int64_t*>(col_1->buffers[1]);
+    auto col_2_values = reinterpret_cast<const int64_t*>(col_2->buffers[1]);
+    auto col_2_validity = reinterpret_cast<const uint8_t*>(col_2->buffers[0]);
+    std::vector<int64_t> expected_col_2{1, 1, 2, 2, 2, 3};
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_EQ(col_1_values[i], 10);
+      EXPECT_EQ(CiderBitUtils::isBitSetAt(col_2_validity, i), i < 2 || i == 5);
+      if (i < 2 || i == 5) {
+        EXPECT_EQ(col_2_values[i], expected_col_2[i]);
+      }
+    }
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  }
+}
+
+TEST(CiderBatchProcessorTest, morselParallelTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT);
+        )";
+  auto context =
+      std::make_shared<BatchProcessorContext>(std::make_shared<CiderDefaultAllocator>());
+  context->setParallelism(4);
+  context->setMorselSize(64);
+  auto processor = createBatchProcessorFromSql(
+      "SELECT col_1, col_2 + 1 FROM test WHERE col_1 > 100", ddl, context);
+
+  constexpr int64_t kRowNum = 1000;
+  std::vector<int64_t> col_1(kRowNum), col_2(kRowNum);
+  std::vector<bool> col_2_nulls(kRowNum);
+  for (int64_t i = 0; i < kRowNum; ++i) {
+    col_1[i] = i;
+    col_2[i] = kRowNum - i;
+    col_2_nulls[i] = i % 7 == 0;
+  }
+  auto&& [input_schema, input_array] =
+      ArrowArrayBuilder()
+          .setRowNum(kRowNum)
+          .addColumn<int64_t>("col_1", CREATE_SUBSTRAIT_TYPE(I64), col_1)
+          .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), col_2, col_2_nulls)
+          .build();
+  processor->processNextBatch(input_array, input_schema);
+
+  // Output of morsels is concatenated in input order.
+  struct ArrowArray output_array;
+  struct ArrowSchema output_schema;
+  processor->getResult(output_array, output_schema);
+  ASSERT_EQ(output_array.length, kRowNum - 101);
+  auto col_1_array = output_array.children[0];
+  auto sum = output_array.children[1];
+  auto col_1_values = reinterpret_cast<const int64_t*>(col_1_array->buffers[1]);
+  auto sum_values = reinterpret_cast<const int64_t*>(sum->buffers[1]);
+  auto sum_validity = reinterpret_cast<const uint8_t*>(sum->buffers[0]);
+  for (int64_t i = 0; i < output_array.length; ++i) {
+    auto row = i + 101;
+    EXPECT_EQ(col_1_values[i], row);
+    EXPECT_EQ(CiderBitUtils::isBitSetAt(sum_validity, i), row % 7 != 0);
+    if (row % 7 != 0) {
+      EXPECT_EQ(sum_values[i], kRowNum - row + 1);
+    }
+  }
+  output_array.release(&output_array);
+  output_schema.release(&output_schema);
+}
+
+TEST(CiderBatchProcessorTest, inputCoalescingTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT NOT NULL);
+        )";
+  auto context =
+      std::make_shared<BatchProcessorContext>(std::make_shared<CiderDefaultAllocator>());
+  context->setMinInputRows(10);
+  auto processor = createBatchProcessorFromSql(
+      "SELECT col_1 + col_2 FROM test WHERE col_1 < col_2", ddl, context);
+
+  auto add_input = [&processor](int64_t first, int64_t row_num) {
+    std::vector<int64_t> col_1(row_num), col_2(row_num, 100);
+    std::iota(col_1.begin(), col_1.end(), first);
+    auto&& [input_schema, input_array] =
+        ArrowArrayBuilder()
+            .setRowNum(row_num)
+            .addColumn<int64_t>("col_1", CREATE_SUBSTRAIT_TYPE(I64), col_1)
+            .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), col_2)
+            .build();
+    processor->processNextBatch(input_array, input_schema);
+  };
+  auto check_result = [&processor](int64_t first, int64_t row_num) {
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    ASSERT_EQ(output_array.length, row_num);
+    if (row_num == 0) {
+      return;
+    }
+    auto values = reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+    for (int64_t i = 0; i < row_num; ++i) {
+      EXPECT_EQ(values[i], first + i + 100);
+    }
+    output_array.release(&output_array);
+    output_schema.release(&output_schema);
+  };
+
+  // Batches are buffered until 10 rows are reached, then run once in input order.
+  add_input(0, 4);
+  check_result(0, 0);
+  add_input(4, 4);
+  check_result(0, 0);
+  add_input(8, 4);
+  check_result(0, 12);
+
+  // Remaining rows are run once no more batch will come.
+  add_input(12, 2);
+  check_result(0, 0);
+  processor->finish();
+  check_result(12, 2);
+  check_result(0, 0);
+  EXPECT_EQ(processor->getState(), BatchProcessorState::kFinished);
+
+  auto default_processor = std::dynamic_pointer_cast<DefaultBatchProcessor>(processor);
+  ASSERT_NE(default_processor, nullptr);
+  EXPECT_EQ(default_processor->getInputBatchNum(), 4);
+  EXPECT_EQ(default_processor->getInputRowNum(), 14);
+  EXPECT_EQ(default_processor->getProcessedBatchNum(), 2);
+}
+
+TEST(CiderBatchProcessorTest, maxOutputRowsTest) {
+  std::string ddl = R"(
+        CREATE TABLE test(col_1 BIGINT NOT NULL, col_2 BIGINT NOT NULL);
+        )";
+  auto context =
+      std::make_shared<BatchProcessorContext>(std::make_shared<CiderDefaultAllocator>());
+  context->setMaxOutputRows(3);
+  auto processor = createBatchProcessorFromSql(
+      "SELECT col_1 + col_2 FROM test WHERE col_1 < col_2", ddl, context);
+
+  auto build_input = []() {
+    std::vector<int64_t> col_1(10), col_2(10, 100);
+    std::iota(col_1.begin(), col_1.end(), 0);
+    return ArrowArrayBuilder()
+        .setRowNum(10)
+        .addColumn<int64_t>("col_1", CREATE_SUBSTRAIT_TYPE(I64), col_1)
+        .addColumn<int64_t>("col_2", CREATE_SUBSTRAIT_TYPE(I64), col_2)
+        .build();
+  };
+
+  for (int batch = 0; batch < 2; ++batch) {
+    auto&& [input_schema, input_array] = build_input();
+    processor->processNextBatch(input_array, input_schema);
+
+    // Output of the batch is split into batches of at most 3 rows.
+    int64_t expected = 100;
+    for (int64_t expected_len : {3, 3, 3, 1}) {
+      if (expected_len != 1) {
+        EXPECT_TRUE(processor->hasPendingOutput());
+        auto&& [next_schema, next_array] = build_input();
+        EXPECT_THROW(processor->processNextBatch(next_array, next_schema),
+                     CiderRuntimeException);
+        next_array->release(next_array);
+        next_schema->release(next_schema);
+      }
+      struct ArrowArray output_array;
+      struct ArrowSchema output_schema;
+      processor->getResult(output_array, output_schema);
+      ASSERT_EQ(output_array.length, expected_len);
+      auto values =
+          reinterpret_cast<const int64_t*>(output_array.children[0]->buffers[1]);
+      for (int64_t i = 0; i < expected_len; ++i) {
+        EXPECT_EQ(values[i], expected++);
+      }
+      output_array.release(&output_array);
+      output_schema.release(&output_schema);
+    }
+    EXPECT_FALSE(processor->hasPendingOutput());
+
+    struct ArrowArray output_array;
+    struct ArrowSchema output_schema;
+    processor->getResult(output_array, output_schema);
+    EXPECT_EQ(output_array.length, 0);
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
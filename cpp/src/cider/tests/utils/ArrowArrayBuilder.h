@@ -23,6 +23,7 @@
 
 #include "cider/CiderBatch.h"
 #include "cider/batch/CiderBatchUtils.h"
+#include "exec/plan/parser/TypeUtils.h"
 
 #ifndef CIDER_DUCKDBQUERYRUNNER_H
 #include "exec/module/batch/ArrowABI.h"
@@ -301,6 +302,138 @@ class ArrowArrayBuilder {
     return *this;
   }
 
+  // Dictionary-encoded UTF8 column with INT32 indices, row i takes the value
+  // indices[i] of the dictionary defined by dict_data and dict_offsets.
+  ArrowArrayBuilder& addDictionaryUTF8Column(const std::string& col_name,
+                                             const std::string& dict_data,
+                                             const std::vector<int32_t>& dict_offsets,
+                                             const std::vector<int32_t>& indices,
+                                             const std::vector<bool>& null_data = {}) {
+    if (!is_row_num_set_ ||  // have not set row num, use this col_data's row num
+        row_num_ == 0) {     // previous columns are all empty
+      is_row_num_set_ = true;
+      row_num_ = indices.size();
+    }
+    CHECK_EQ(row_num_, indices.size());
+    if (!null_data.empty()) {
+      CHECK_EQ(row_num_, null_data.size());
+    }
+
+    // Dictionary
+    ArrowArray* dict_array = CiderBatchUtils::allocateArrowArray();
+    ArrowSchema* dict_schema = CiderBatchUtils::allocateArrowSchema();
+    dict_schema->name = "";
+    dict_schema->format = "u";
+    dict_schema->release = CiderBatchUtils::ciderEmptyArrowSchemaReleaser;
+
+    size_t dict_size = dict_offsets.size() - 1;
+    dict_array->length = dict_size;
+    dict_array->n_buffers = 3;
+    dict_array->buffers = (const void**)allocator_->allocate(sizeof(void*) * 3);
+    dict_array->buffers[0] = nullptr;
+    int32_t* offset_buf =
+        (int32_t*)allocator_->allocate(sizeof(int32_t) * (dict_size + 1));
+    std::memcpy(offset_buf, dict_offsets.data(), sizeof(int32_t) * (dict_size + 1));
+    dict_array->buffers[1] = offset_buf;
+    dict_array->buffers[2] = allocator_->allocate(std::max<size_t>(dict_data.size(), 1));
+    memcpy(const_cast<void*>(dict_array->buffers[2]), dict_data.data(), dict_data.size());
+    dict_array->release = CiderBatchUtils::ciderEmptyArrowArrayReleaser;
+
+    // Indices
+    ArrowArray* current_array = CiderBatchUtils::allocateArrowArray();
+    ArrowSchema* current_schema = CiderBatchUtils::allocateArrowSchema();
+    current_schema->name = col_name.c_str();
+    current_schema->format = "i";
+    current_schema->dictionary = dict_schema;
+    current_schema->release = CiderBatchUtils::ciderEmptyArrowSchemaReleaser;
+
+    current_array->length = row_num_;
+    current_array->n_buffers = 2;
+    current_array->buffers = (const void**)allocator_->allocate(sizeof(void*) * 2);
+    size_t bitmap_size = (row_num_ + 7) >> 3;
+    void* null_buf = (void*)allocator_->allocate(bitmap_size);
+    std::memset(null_buf, 0xFF, bitmap_size);
+    for (auto i = 0; i < null_data.size(); i++) {
+      if (null_data[i]) {
+        CiderBitUtils::clearBitAt((uint8_t*)null_buf, i);
+        current_array->null_count++;
+      }
+    }
+    current_array->buffers[0] = null_buf;
+    int32_t* index_buf = (int32_t*)allocator_->allocate(sizeof(int32_t) * row_num_);
+    std::memcpy(index_buf, indices.data(), sizeof(int32_t) * row_num_);
+    current_array->buffers[1] = index_buf;
+    current_array->dictionary = dict_array;
+    current_array->release = CiderBatchUtils::ciderEmptyArrowArrayReleaser;
+
+    array_list_.push_back(current_array);
+    schema_list_.push_back(current_schema);
+    return *this;
+  }
+
+  // A column of a single value which applies to every row of the batch.
+  template <class T>
+  ArrowArrayBuilder& addConstantColumn(const std::string& col_name,
+                                       const ::substrait::Type& col_type,
+                                       const T& value,
+                                       bool is_null = false) {
+    ArrowArray* current_array = nullptr;
+    ArrowSchema* current_schema = nullptr;
+    std::tie(current_schema, current_array) = generatePrimitiveColumn(
+        col_name, col_type, std::vector<T>{value}, {is_null}, false);
+    array_list_.push_back(current_array);
+    schema_list_.push_back(current_schema);
+    return *this;
+  }
+
+  // Defined by INT32 run ends and a child array of values, one value per run.
+  template <class T>
+  ArrowArrayBuilder& addRunEndEncodedColumn(const std::string& col_name,
+                                            const ::substrait::Type& col_type,
+                                            const std::vector<int32_t>& run_ends,
+                                            const std::vector<T>& values,
+                                            const std::vector<bool>& null_data = {}) {
+    CHECK_EQ(run_ends.size(), values.size());
+    if (!is_row_num_set_ ||  // have not set row num, use this col_data's row num
+        row_num_ == 0) {     // previous columns are all empty
+      is_row_num_set_ = true;
+      row_num_ = run_ends.empty() ? 0 : run_ends.back();
+    }
+    CHECK_EQ(row_num_, run_ends.empty() ? 0 : run_ends.back());
+
+    ArrowArray* run_ends_array = nullptr;
+    ArrowSchema* run_ends_schema = nullptr;
+    std::tie(run_ends_schema, run_ends_array) = generatePrimitiveColumn(
+        "run_ends", CREATE_SUBSTRAIT_TYPE(I32), run_ends, {}, false);
+    ArrowArray* values_array = nullptr;
+    ArrowSchema* values_schema = nullptr;
+    std::tie(values_schema, values_array) =
+        generatePrimitiveColumn("values", col_type, values, null_data, false);
+
+    ArrowArray* current_array = CiderBatchUtils::allocateArrowArray();
+    ArrowSchema* current_schema = CiderBatchUtils::allocateArrowSchema();
+    current_schema->name = col_name.c_str();
+    current_schema->format = "+r";
+    current_schema->n_children = 2;
+    current_schema->children =
+        (ArrowSchema**)allocator_->allocate(sizeof(ArrowSchema*) * 2);
+    current_schema->children[0] = run_ends_schema;
+    current_schema->children[1] = values_schema;
+    current_schema->release = CiderBatchUtils::ciderEmptyArrowSchemaReleaser;
+
+    current_array->length = row_num_;
+    current_array->n_buffers = 0;
+    current_array->n_children = 2;
+    current_array->children = (ArrowArray**)allocator_->allocate(sizeof(ArrowArray*) * 2);
+    current_array->children[0] = run_ends_array;
+    current_array->children[1] = values_array;
+    current_array->release = CiderBatchUtils::ciderEmptyArrowArrayReleaser;
+
+    array_list_.push_back(current_array);
+    schema_list_.push_back(current_schema);
+    return *this;
+  }
+
   // Defined by a validity bitmap and an offsets buffer, and a child array.
   template <class T>
   ArrowArrayBuilder& addSingleDimensionArrayColumn(
@@ -22,6 +22,7 @@
 #include "exec/nextgen/jitlib/base/JITValue.h"
 #include "exec/nextgen/utils/JITExprValue.h"
 #include "exec/template/Execute.h"  // for is_unnest
+#include "function/string/StringLike.h"
 #include "util/Logger.h"
 
 namespace Analyzer {
@@ -77,6 +78,10 @@ JITExprValue& BinOper::codegen(CodegenContext& context) {
       VarSizeJITExprValue rhs_val(rhs->codegen(context));
       JITValuePointer null = func.createVariable(JITTypeTag::BOOL, "null_val");
       null = lhs_val.getNull() || rhs_val.getNull();
+      if (auto cmp_res = codegenVarcharConstantCmp(context, lhs_val, rhs_val);
+          cmp_res.get()) {
+        return set_expr_value(null, cmp_res);
+      }
       return codegenVarcharCmpFun(func, null, lhs_val, rhs_val);
     } else {
       CIDER_THROW(CiderUnsupportedException, "string BinOp only supports comparison");
@@ -340,6 +345,12 @@ JITExprValue& BinOper::codegenVarcharCmpFun(JITFunction& func,
   if (get_optype() == kBW_EQ or get_optype() == kBW_NE) {
     return codegenVarcharDistinctFrom(func, lhs, rhs);
   }
+  return set_expr_value(null, codegenVarcharCmp(func, lhs, rhs));
+}
+
+JITValuePointer BinOper::codegenVarcharCmp(JITFunction& func,
+                                           VarSizeJITExprValue& lhs,
+                                           VarSizeJITExprValue& rhs) {
   const std::unordered_map<SQLOps, std::string> op_to_func_map{{kEQ, "string_eq"},
                                                                {kNE, "string_ne"},
                                                                {kLT, "string_lt"},
@@ -353,15 +364,61 @@ JITExprValue& BinOper::codegenVarcharCmpFun(JITFunction& func,
                 fmt::format("unsupported varchar optype: {}", optype));
   }
   std::string func_name = it->second;
-  auto cmp_res = func.emitRuntimeFunctionCall(
+  return func.emitRuntimeFunctionCall(
       func_name,
       JITFunctionEmitDescriptor{.ret_type = JITTypeTag::BOOL,
                                 .params_vector = {lhs.getValue().get(),
                                                   lhs.getLength().get(),
                                                   rhs.getValue().get(),
                                                   rhs.getLength().get()}});
+}
+
+JITValuePointer BinOper::codegenVarcharConstantCmp(CodegenContext& context,
+                                                   VarSizeJITExprValue& lhs_val,
+                                                   VarSizeJITExprValue& rhs_val) {
+  auto lhs = const_cast<Analyzer::Expr*>(get_left_operand());
+  auto rhs = const_cast<Analyzer::Expr*>(get_right_operand());
+  auto lhs_literal = dynamic_cast<Analyzer::Constant*>(lhs);
+  auto rhs_literal = dynamic_cast<Analyzer::Constant*>(rhs);
+  if (get_optype() == kBW_EQ || get_optype() == kBW_NE ||
+      (lhs_literal == nullptr) == (rhs_literal == nullptr)) {
+    return JITValuePointer(nullptr);
+  }
+  auto literal = lhs_literal ? lhs_literal : rhs_literal;
+  if (literal->get_is_null()) {
+    return JITValuePointer(nullptr);
+  }
 
-  return set_expr_value(null, cmp_res);
+  // the predicate compares the varchar operand with the constant
+  SQLOps op = lhs_literal ? COMMUTE_COMPARISON(get_optype()) : get_optype();
+  auto predicate = [literal_str = *literal->get_constval().stringval,
+                    op](std::string_view str) {
+    int32_t cmp =
+        StringCompare(str.data(), str.size(), literal_str.data(), literal_str.size());
+    switch (op) {
+      case kEQ:
+        return cmp == 0;
+      case kNE:
+        return cmp != 0;
+      case kLT:
+        return cmp < 0;
+      case kLE:
+        return cmp <= 0;
+      case kGT:
+        return cmp > 0;
+      case kGE:
+        return cmp >= 0;
+      default:
+        UNREACHABLE();
+    }
+    return false;
+  };
+  JITFunction& func = *context.getJITFunction();
+  auto arg = lhs_literal ? rhs : lhs;
+  auto& arg_val = lhs_literal ? rhs_val : lhs_val;
+  return codegenDictionaryPredicate(context, arg, arg_val, predicate, [&]() {
+    return codegenVarcharCmp(func, lhs_val, rhs_val);
+  });
 }
 
 JITExprValue& BinOper::codegenVarcharDistinctFrom(JITFunction& func,
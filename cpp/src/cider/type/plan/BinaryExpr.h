@@ -173,6 +173,16 @@ class BinOper : public Expr {
                                      VarSizeJITExprValue& lhs,
                                      VarSizeJITExprValue& rhs);
 
+  JITValuePointer codegenVarcharCmp(JITFunction& func,
+                                    VarSizeJITExprValue& lhs,
+                                    VarSizeJITExprValue& rhs);
+
+  // Comparison of a varchar with a constant, evaluated once per dictionary entry of
+  // dictionary-encoded input. Returns nullptr if no operand is a constant.
+  JITValuePointer codegenVarcharConstantCmp(CodegenContext& context,
+                                            VarSizeJITExprValue& lhs_val,
+                                            VarSizeJITExprValue& rhs_val);
+
   JITExprValue& codegenVarcharDistinctFrom(JITFunction& func,
                                            VarSizeJITExprValue& lhs,
                                            VarSizeJITExprValue& rhs);
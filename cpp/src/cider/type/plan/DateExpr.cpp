@@ -20,6 +20,7 @@
  */
 #include "type/plan/DateExpr.h"
 #include "exec/template/DateTimeUtils.h"
+#include "type/plan/ConstantExpr.h"
 
 namespace Analyzer {
 using namespace cider::jitlib;
@@ -118,6 +119,40 @@ JITValuePointer getExtractHighPrecisionTime(JITValuePointer time_val,
   return time_val / DateTimeUtils::get_timestamp_precision_scale(ti.get_dimension());
 }
 
+void DateaddExpr::initAutoVectorizeFlag() {
+  // Adding to a date is plain 32-bit arithmetic, see date_add_seconds and
+  // date_add_months. Timestamps are left to the row based path.
+  auto constant = std::dynamic_pointer_cast<Constant>(number_);
+  bool number_vectorizable =
+      number_->isAutoVectorizable() || (constant && !constant->get_is_null());
+  auto_vectorizable_ = datetime_->isAutoVectorizable() &&
+                       datetime_->get_type_info().get_type() == kDATE &&
+                       number_vectorizable;
+}
+
+void ExtractExpr::initAutoVectorizeFlag() {
+  if (!from_expr_->isAutoVectorizable() ||
+      from_expr_->get_type_info().get_type() != kDATE) {
+    auto_vectorizable_ = false;
+    return;
+  }
+  // Fields computed from CivilDate or plain modulo, the week extraction still goes
+  // through MonthDaySecond.
+  switch (field_) {
+    case kYEAR:
+    case kQUARTER:
+    case kMONTH:
+    case kDAY:
+    case kDOW:
+    case kISODOW:
+    case kDOY:
+      auto_vectorizable_ = true;
+      return;
+    default:
+      auto_vectorizable_ = false;
+  }
+}
+
 JITExprValue& DateaddExpr::codegen(CodegenContext& context) {
   JITFunction& func = *context.getJITFunction();
   const SQLTypeInfo& expr_ti = get_type_info();
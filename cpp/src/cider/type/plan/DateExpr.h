@@ -39,7 +39,9 @@ class DateaddExpr : public Expr {
               const DateaddField f,
               const std::shared_ptr<Analyzer::Expr> number,
               const std::shared_ptr<Analyzer::Expr> datetime)
-      : Expr(ti, false), field_(f), number_(number), datetime_(datetime) {}
+      : Expr(ti, false), field_(f), number_(number), datetime_(datetime) {
+    initAutoVectorizeFlag();
+  }
   DateaddField get_field() const { return field_; }
   const std::shared_ptr<Analyzer::Expr> get_number() const { return number_; }
   const std::shared_ptr<Analyzer::Expr> get_datetime() const { return datetime_; }
@@ -75,6 +77,8 @@ class DateaddExpr : public Expr {
   }
 
  private:
+  void initAutoVectorizeFlag();
+
   DateaddField field_;
   std::shared_ptr<Analyzer::Expr> number_;
   std::shared_ptr<Analyzer::Expr> datetime_;
@@ -90,7 +94,9 @@ class ExtractExpr : public Expr {
               bool has_agg,
               ExtractField f,
               std::shared_ptr<Analyzer::Expr> e)
-      : Expr(ti, has_agg), field_(f), from_expr_(e) {}
+      : Expr(ti, has_agg), field_(f), from_expr_(e) {
+    initAutoVectorizeFlag();
+  }
   ExtractField get_field() const { return field_; }
   Expr* get_from_expr() const { return from_expr_.get(); }
   const std::shared_ptr<Analyzer::Expr> get_own_from_expr() const { return from_expr_; }
@@ -122,6 +128,8 @@ class ExtractExpr : public Expr {
   ExprPtrRefVector get_children_reference() override { return {&(from_expr_)}; }
 
  private:
+  void initAutoVectorizeFlag();
+
   ExtractField field_;
   std::shared_ptr<Analyzer::Expr> from_expr_;
 };
@@ -20,6 +20,8 @@
  * under the License.
  */
 #include "type/plan/Expr.h"
+#include "exec/nextgen/context/Batch.h"
+#include "type/plan/ColumnExpr.h"
 #include "type/plan/UnaryExpr.h"
 
 namespace Analyzer {
@@ -35,6 +37,46 @@ JITExprValue& Expr::codegenNull(CodegenContext& context) {
   UNREACHABLE();
   return expr_var_;
 }
+
+JITValuePointer Expr::codegenDictionaryPredicate(
+    CodegenContext& context,
+    Expr* arg,
+    VarSizeJITExprValue& arg_val,
+    CodegenContext::StringPredicate predicate,
+    const std::function<JITValuePointer()>& row_predicate) {
+  auto column_var = dynamic_cast<Analyzer::ColumnVar*>(arg);
+  if (!column_var || !column_var->getLocalIndex()) {
+    return row_predicate();
+  }
+  using cider::exec::nextgen::context::batch_runtime_utils::ArrowArrayEncoding;
+  JITFunction& func = *context.getJITFunction();
+  auto&& [batch, buffers] = context.getArrowArrayValues(column_var->getLocalIndex());
+  VarSizeJITExprValue column_values(buffers);
+  int id = context.registerDictionaryPredicate(std::move(predicate));
+  // The encoding is loop-invariant, the branch is unswitched out of the row loop.
+  auto encoding = func.createLocalJITValue(
+      [&batch]() { return codegen_utils::getArrowArrayEncoding(batch); });
+  auto results = func.createLocalJITValue(
+      [&]() { return context.registerDictionaryPredicateResults(batch, id); });
+
+  auto ret = func.createVariable(JITTypeTag::BOOL, "dictionary_predicate", false);
+  func.createIfBuilder()
+      ->condition([&encoding]() {
+        return encoding == static_cast<int32_t>(ArrowArrayEncoding::kDictionary);
+      })
+      ->ifTrue([&]() {
+        ret = *func.emitRuntimeFunctionCall(
+            "cider_dictionary_predicate_result",
+            JITFunctionEmitDescriptor{.ret_type = JITTypeTag::BOOL,
+                                      .params_vector = {results.get(),
+                                                        arg_val.getValue().get(),
+                                                        arg_val.getLength().get(),
+                                                        column_values.getValue().get()}});
+      })
+      ->ifFalse([&]() { ret = *row_predicate(); })
+      ->build();
+  return ret;
+}
 }  // namespace Analyzer
 
 std::shared_ptr<Analyzer::Expr> remove_cast(const std::shared_ptr<Analyzer::Expr>& expr) {
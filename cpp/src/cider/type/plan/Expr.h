@@ -210,6 +210,16 @@ class Expr : public std::enable_shared_from_this<Expr> {
     return cider::exec::nextgen::utils::getJITTypeTag(st);
   }
 
+  // Emits a BOOL predicate of a string. If arg is a dictionary-encoded input column, the
+  // predicate is evaluated once per dictionary entry and rows look up its result,
+  // otherwise row_predicate is emitted.
+  JITValuePointer codegenDictionaryPredicate(
+      CodegenContext& context,
+      Expr* arg,
+      VarSizeJITExprValue& arg_val,
+      CodegenContext::StringPredicate predicate,
+      const std::function<JITValuePointer()>& row_predicate);
+
  protected:
   SQLTypeInfo type_info;  // SQLTypeInfo of the return result of this expression
   bool contains_agg;
@@ -224,6 +224,27 @@ CiderSetPtr insertValuesToSet(
   return std::move(set);
 }
 
+// Sorted, deduplicated non-null values of an integer IN list.
+std::vector<int64_t> collectIntegerValues(
+    const std::list<std::shared_ptr<Analyzer::Expr>>& val_list) {
+  std::vector<int64_t> values;
+  values.reserve(val_list.size());
+  for (auto in_val : val_list) {
+    const auto in_val_const =
+        dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(in_val.get()));
+    if (!in_val_const) {
+      CIDER_THROW(CiderCompileException, "InValues only support constant value list.");
+    }
+    if (in_val_const->get_type_info().get_notnull()) {
+      values.push_back(extract_int_type_from_datum(in_val_const->get_constval(),
+                                                   in_val_const->get_type_info()));
+    }
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
 std::string get_fn_name(const SQLTypeInfo& type_info) {
   switch (type_info.get_type()) {
     case kTINYINT:
@@ -261,16 +282,13 @@ JITExprValue& InValues::codegen(CodegenContext& context) {
   }
   FixSizeJITExprValue in_arg_val(in_arg->codegen(context));
   auto null_value = in_arg_val.getNull();
+  if (in_arg->get_type_info().is_integer()) {
+    return set_expr_value(null_value, codegenForInteger(context, in_arg_val.getValue()));
+  }
   // For values count >= 3, use CiderSet for evaluation
   // Otherwise, translate it into OR exprs
   if (get_value_list().size() >= 3) {
-    CiderSetPtr cider_set;
-    if (in_arg->get_type_info().is_integer()) {
-      cider_set = std::make_unique<CiderInt64Set>();
-    }
-    if (in_arg->get_type_info().is_fp()) {
-      cider_set = std::make_unique<CiderDoubleSet>();
-    }
+    CiderSetPtr cider_set = std::make_unique<CiderDoubleSet>();
     auto filled_set = insertValuesToSet(std::move(cider_set), get_value_list());
     auto set_ptr = context.registerCiderSet("in_set", expr_ti, std::move(filled_set));
     auto emit_desc = JITFunctionEmitDescriptor{
@@ -298,14 +316,77 @@ JITExprValue& InValues::codegen(CodegenContext& context) {
   UNREACHABLE();
 }
 
+JITValuePointer InValues::codegenForInteger(CodegenContext& context,
+                                            JITValuePointer& arg_val) {
+  // Up to kMaxInlinedRuns runs of consecutive values are compiled into equality and
+  // range checks, short lists unroll into compares LLVM can vectorize. Longer lists
+  // probe a bitmap if the values are dense enough, a flat hash set otherwise.
+  constexpr size_t kMaxInlinedRuns = 8;
+  constexpr uint64_t kMaxBitmapRange = 1 << 16;
+  constexpr uint64_t kMinBitmapDensity = 64;
+
+  JITFunction& func = *context.getJITFunction();
+  auto values = collectIntegerValues(get_value_list());
+  if (values.empty()) {
+    return func.createLiteral(JITTypeTag::BOOL, false);
+  }
+
+  std::vector<std::pair<int64_t, int64_t>> runs;
+  for (auto value : values) {
+    if (!runs.empty() && runs.back().second + 1 == value) {
+      runs.back().second = value;
+    } else {
+      runs.emplace_back(value, value);
+    }
+  }
+
+  if (runs.size() <= kMaxInlinedRuns) {
+    // Compare in 64 bits as list values may not fit the argument type.
+    auto value = arg_val->castJITValuePrimitiveType(JITTypeTag::INT64);
+    JITValuePointer val = func.createLiteral(JITTypeTag::BOOL, false);
+    for (auto& [low, high] : runs) {
+      if (low == high) {
+        val.replace(val || (value == low));
+      } else {
+        val.replace(val || ((value >= low) && (value <= high)));
+      }
+    }
+    return val;
+  }
+
+  CiderSetPtr cider_set;
+  std::string fn_name = get_fn_name(arg->get_type_info());
+  // The span of the values is computed in unsigned arithmetic, it doesn't fit int64_t
+  // if the list holds both large negative and large positive values and the range
+  // would wrap to 0 if it's the whole int64_t domain.
+  uint64_t span =
+      static_cast<uint64_t>(values.back()) - static_cast<uint64_t>(values.front());
+  if (span < kMaxBitmapRange && span < values.size() * kMinBitmapDensity) {
+    cider_set = std::make_unique<CiderBitmapSet>(values.front(), values.back());
+    fn_name = "cider_bitmap_" + fn_name.substr(std::string("cider_").size());
+  } else {
+    cider_set = std::make_unique<CiderInt64Set>();
+  }
+  for (auto value : values) {
+    cider_set->insert(value);
+  }
+  auto set_ptr =
+      context.registerCiderSet("in_set", get_type_info(), std::move(cider_set));
+  return func.emitRuntimeFunctionCall(
+      fn_name,
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::BOOL,
+                                .params_vector = {set_ptr.get(), arg_val.get()}});
+}
+
 JITExprValue& InValues::codegenForString(CodegenContext& context) {
   JITFunction& func = *context.getJITFunction();
   auto in_arg = const_cast<Analyzer::Expr*>(get_arg());
   VarSizeJITExprValue in_arg_val(in_arg->codegen(context));
   auto null_value = in_arg_val.getNull();
-  // For values count >= 3, use CiderSet for evaluation
-  // Otherwise, translate it into OR exprs
-  if (get_value_list().size() >= 3) {
+  // Short lists are compiled into length-first comparisons against the literals, which
+  // beats hashing the probe. Longer lists use the arena backed CiderStringSet.
+  constexpr size_t kMaxInlinedStringValues = 8;
+  if (get_value_list().size() > kMaxInlinedStringValues) {
     CiderSetPtr cider_set = std::make_unique<CiderStringSet>();
     auto filled_set = insertValuesToSet(std::move(cider_set), get_value_list());
     auto set_ptr =
@@ -329,7 +410,7 @@ JITExprValue& InValues::codegenForString(CodegenContext& context) {
       if (in_val_const->get_type_info().get_notnull()) {
         VarSizeJITExprValue in_val_const_jit(in_val_const->codegen(context));
         auto cmp_res = func.emitRuntimeFunctionCall(
-            "string_eq",
+            "cider_string_eq_literal",
             JITFunctionEmitDescriptor{
                 .ret_type = JITTypeTag::BOOL,
                 .params_vector = {in_arg_val.getValue().get(),
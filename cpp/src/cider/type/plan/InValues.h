@@ -79,6 +79,7 @@ class InValues : public Expr {
   ExprPtrRefVector get_children_reference() override { return {&arg}; }
   JITExprValue& codegen(CodegenContext& context);
   JITExprValue& codegenForString(CodegenContext& context);
+  JITValuePointer codegenForInteger(CodegenContext& context, JITValuePointer& arg_val);
 
  private:
   std::shared_ptr<Analyzer::Expr> arg;  // the argument left of IN
@@ -19,14 +19,149 @@
  * under the License.
  */
 #include "type/plan/LikeExpr.h"
+
+#include <optional>
+
 #include "exec/nextgen/jitlib/base/JITValue.h"
 #include "exec/template/Execute.h"  // for is_unnest
+#include "function/string/StringLike.h"
 
 namespace Analyzer {
 using namespace cider::jitlib;
 
+namespace {
+// Literal of a LIKE pattern, preceded by `skip` '_' wildcards.
+struct LikePart {
+  int32_t skip;
+  std::string literal;
+};
+
+// Text between two '%' of a LIKE pattern.
+struct LikeBlock {
+  std::vector<LikePart> parts;
+  int32_t tail_skip{0};
+
+  int32_t length() const {
+    int32_t len = tail_skip;
+    for (auto& part : parts) {
+      len += part.skip + part.literal.size();
+    }
+    return len;
+  }
+};
+
+// Splits a LIKE pattern by '%', returns nullopt if the pattern has char classes.
+std::optional<std::vector<LikeBlock>> splitLikePattern(const std::string& pattern,
+                                                       char escape_char) {
+  std::vector<LikeBlock> blocks(1);
+  int32_t skip = 0;
+  std::string literal;
+  auto flush_literal = [&]() {
+    if (!literal.empty()) {
+      blocks.back().parts.push_back({skip, std::move(literal)});
+      skip = 0;
+      literal.clear();
+    }
+  };
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    if (c == escape_char) {
+      if (++i == pattern.size()) {
+        return std::nullopt;
+      }
+      literal.push_back(pattern[i]);
+    } else if (c == '%') {
+      flush_literal();
+      blocks.back().tail_skip = skip;
+      skip = 0;
+      blocks.emplace_back();
+    } else if (c == '_') {
+      flush_literal();
+      ++skip;
+    } else if (c == '[') {
+      return std::nullopt;
+    } else {
+      literal.push_back(c);
+    }
+  }
+  flush_literal();
+  blocks.back().tail_skip = skip;
+  return blocks;
+}
+
+// Emits a LIKE pattern as a chain of literal matches. The first and the last block are
+// anchored at the start and the end of the string, blocks in between are searched for
+// from left to right, which can't miss a match as every block may start anywhere after
+// its predecessor. Returns nullptr if a searched block has '_' between its literals.
+JITValuePointer codegenLikeBlocks(JITFunction& func,
+                                  VarSizeJITExprValue& arg_val,
+                                  const std::vector<LikeBlock>& blocks) {
+  for (size_t i = 1; i + 1 < blocks.size(); ++i) {
+    if (blocks[i].parts.size() > 1) {
+      return JITValuePointer(nullptr);
+    }
+  }
+
+  JITValuePointer pos = func.createLiteral(JITTypeTag::INT32, int32_t(0));
+  int32_t skip = 0;
+  auto emit_part = [&](const char* fn_name, const LikePart& part) {
+    pos.replace(func.emitRuntimeFunctionCall(
+        fn_name,
+        JITFunctionEmitDescriptor{
+            .ret_type = JITTypeTag::INT32,
+            .params_vector = {
+                arg_val.getValue().get(),
+                arg_val.getLength().get(),
+                pos.get(),
+                func.createLiteral(JITTypeTag::INT32, skip + part.skip).get(),
+                func.createStringLiteral(part.literal).get(),
+                func.createLiteral(JITTypeTag::INT32, int32_t(part.literal.size()))
+                    .get()}}));
+    skip = 0;
+  };
+  auto emit_anchored_block = [&](const LikeBlock& block) {
+    for (auto& part : block.parts) {
+      emit_part("string_like_match_at", part);
+    }
+    skip += block.tail_skip;
+  };
+
+  bool exact = blocks.size() == 1;
+  emit_anchored_block(blocks.front());
+  for (size_t i = 1; i + 1 < blocks.size(); ++i) {
+    if (blocks[i].parts.empty()) {
+      skip += blocks[i].tail_skip;
+    } else {
+      emit_part("string_like_find", blocks[i].parts.front());
+      skip = blocks[i].tail_skip;
+    }
+  }
+  if (!exact && blocks.back().length() > 0) {
+    pos.replace(func.emitRuntimeFunctionCall(
+        "string_like_align_end",
+        JITFunctionEmitDescriptor{
+            .ret_type = JITTypeTag::INT32,
+            .params_vector = {
+                arg_val.getLength().get(),
+                pos.get(),
+                func.createLiteral(JITTypeTag::INT32, skip).get(),
+                func.createLiteral(JITTypeTag::INT32, blocks.back().length()).get()}}));
+    skip = 0;
+    emit_anchored_block(blocks.back());
+    exact = true;
+  }
+  return func.emitRuntimeFunctionCall(
+      "string_like_end",
+      JITFunctionEmitDescriptor{
+          .ret_type = JITTypeTag::BOOL,
+          .params_vector = {arg_val.getLength().get(),
+                            pos.get(),
+                            func.createLiteral(JITTypeTag::INT32, skip).get(),
+                            func.createLiteral(JITTypeTag::BOOL, exact).get()}});
+}
+}  // namespace
+
 JITExprValue& LikeExpr::codegen(CodegenContext& context) {
-  JITFunction& func = *context.getJITFunction();
   if (auto expr_val = get_expr_value()) {
     return expr_val;
   }
@@ -42,7 +177,67 @@ JITExprValue& LikeExpr::codegen(CodegenContext& context) {
   CHECK(arg->get_type_info().is_string());
   CHECK(pattern->get_type_info().is_string());
 
+  auto escape_char = char{'\\'};
+  if (escape) {
+    auto escape_char_expr = dynamic_cast<Analyzer::Constant*>(escape);
+    CHECK(escape_char_expr);
+    CHECK(escape_char_expr->get_type_info().is_string());
+    CHECK_EQ(size_t(1), escape_char_expr->get_constval().stringval->size());
+    escape_char = (*escape_char_expr->get_constval().stringval)[0];
+  }
+
   auto arg_val = VarSizeJITExprValue(arg->codegen(context));
+
+  auto pattern_literal = dynamic_cast<Analyzer::Constant*>(pattern);
+  if (!pattern_literal || pattern_literal->get_is_null()) {
+    return set_expr_value(arg_val.getNull(),
+                          codegenRowLike(context, arg_val, escape_char));
+  }
+
+  // Constant patterns are matched once per entry of dictionary-encoded input.
+  auto predicate = [pattern_str = *pattern_literal->get_constval().stringval,
+                    escape_char,
+                    is_ilike = get_is_ilike(),
+                    is_simple = get_is_simple()](std::string_view str) {
+    if (is_simple) {
+      return (is_ilike ? string_ilike_simple : string_like_simple)(
+          str.data(), str.size(), pattern_str.data(), pattern_str.size());
+    }
+    return (is_ilike ? string_ilike : string_like)(
+        str.data(), str.size(), pattern_str.data(), pattern_str.size(), escape_char);
+  };
+  auto match = codegenDictionaryPredicate(context, arg, arg_val, predicate, [&]() {
+    return codegenRowLike(context, arg_val, escape_char);
+  });
+  return set_expr_value(arg_val.getNull(), match);
+}
+
+JITValuePointer LikeExpr::codegenRowLike(CodegenContext& context,
+                                         VarSizeJITExprValue& arg_val,
+                                         char escape_char) {
+  JITFunction& func = *context.getJITFunction();
+  auto pattern = const_cast<Analyzer::Expr*>(get_like_expr());
+
+  // Constant LIKE patterns are compiled into prefix, suffix, exact and substring
+  // matches. ILIKE and patterns with char classes fall back to the generic matcher.
+  auto pattern_literal = dynamic_cast<Analyzer::Constant*>(pattern);
+  if (pattern_literal && !pattern_literal->get_is_null() && !get_is_ilike()) {
+    const std::string& pattern_str = *pattern_literal->get_constval().stringval;
+    std::optional<std::vector<LikeBlock>> blocks;
+    if (get_is_simple()) {
+      // control chars are already erased from simple patterns, i.e. '%<pattern>%'
+      blocks = std::vector<LikeBlock>(3);
+      blocks->at(1).parts.push_back({0, pattern_str});
+    } else {
+      blocks = splitLikePattern(pattern_str, escape_char);
+    }
+    if (blocks) {
+      if (auto match = codegenLikeBlocks(func, arg_val, *blocks); match.get()) {
+        return match;
+      }
+    }
+  }
+
   auto pattern_val = VarSizeJITExprValue(pattern->codegen(context));
 
   std::string fn_name{get_is_ilike() ? "string_ilike" : "string_like"};
@@ -52,15 +247,6 @@ JITExprValue& LikeExpr::codegen(CodegenContext& context) {
                                                   arg_val.getLength().get(),
                                                   pattern_val.getValue().get(),
                                                   pattern_val.getLength().get()}};
-
-  auto escape_char = char{'\\'};
-  if (escape) {
-    auto escape_char_expr = dynamic_cast<Analyzer::Constant*>(escape);
-    CHECK(escape_char_expr);
-    CHECK(escape_char_expr->get_type_info().is_string());
-    CHECK_EQ(size_t(1), escape_char_expr->get_constval().stringval->size());
-    escape_char = (*escape_char_expr->get_constval().stringval)[0];
-  }
   // put escape_char_val here to keep it alive until codegen complete
   auto escape_char_val = func.createLiteral(JITTypeTag::INT8, int8_t(escape_char));
 
@@ -71,8 +257,7 @@ JITExprValue& LikeExpr::codegen(CodegenContext& context) {
     emit_desc.params_vector.push_back(escape_char_val.get());
   }
 
-  return set_expr_value(arg_val.getNull(),
-                        func.emitRuntimeFunctionCall(fn_name, emit_desc));
+  return func.emitRuntimeFunctionCall(fn_name, emit_desc);
 }
 
 std::shared_ptr<Analyzer::Expr> LikeExpr::deep_copy() const {
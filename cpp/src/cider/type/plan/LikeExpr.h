@@ -129,6 +129,12 @@ class LikeExpr : public Expr {
   }
 
   JITExprValue& codegen(CodegenContext& context) override;
+
+ private:
+  // Emits the match of a single row.
+  JITValuePointer codegenRowLike(CodegenContext& context,
+                                 VarSizeJITExprValue& arg_val,
+                                 char escape_char);
 };
 }  // namespace Analyzer
 
@@ -329,20 +329,11 @@ JITExprValue& SubstringStringOper::codegen(CodegenContext& context) {
           .params_vector = {
               pos_param.get(), arg_val.getLength().get(), len_val.getValue().get()}});
 
-  // get string heap ptr
-  auto string_heap_ptr = func.emitRuntimeFunctionCall(
-      "get_query_context_string_heap_ptr",
-      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
-                                .ret_sub_type = JITTypeTag::INT8,
-                                .params_vector = {func.getArgument(0).get()}});
-
-  // call external function
-  auto emit_desc = JITFunctionEmitDescriptor{.ret_type = JITTypeTag::INT64,
-                                             .params_vector = {string_heap_ptr.get(),
-                                                               arg_val.getValue().get(),
-                                                               pos_param.get(),
-                                                               len_param.get()}};
-  std::string fn_name = "cider_substring_extra";
+  // call external function, the substring is a view of the input string
+  auto emit_desc = JITFunctionEmitDescriptor{
+      .ret_type = JITTypeTag::INT64,
+      .params_vector = {arg_val.getValue().get(), pos_param.get(), len_param.get()}};
+  std::string fn_name = "cider_substring";
 
   auto ptr_and_len = func.emitRuntimeFunctionCall(fn_name, emit_desc);
   // decode result
@@ -358,6 +349,33 @@ JITExprValue& SubstringStringOper::codegen(CodegenContext& context) {
   return set_expr_value(arg_val.getNull(), ret_len, ret_ptr);
 }
 
+namespace {
+// LOWER and UPPER of an input column convert the whole data buffer of the column once
+// per batch, rows read converted values at the offsets of their input values. Returns
+// nullptr if arg is not an input column.
+JITValuePointer codegenCaseConvertedColumn(CodegenContext& context,
+                                           Analyzer::Expr* arg,
+                                           VarSizeJITExprValue& arg_val,
+                                           bool upper) {
+  auto column_var = dynamic_cast<Analyzer::ColumnVar*>(arg);
+  if (!column_var || !column_var->getLocalIndex()) {
+    return JITValuePointer(nullptr);
+  }
+  JITFunction& func = *context.getJITFunction();
+  auto&& [batch, buffers] = context.getArrowArrayValues(column_var->getLocalIndex());
+  VarSizeJITExprValue column_values(buffers);
+  auto converted = func.createLocalJITValue(
+      [&]() { return context.registerCaseConvertedStrings(batch, upper); });
+  return func.emitRuntimeFunctionCall(
+      "cider_rebase_string_ptr",
+      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
+                                .ret_sub_type = JITTypeTag::INT8,
+                                .params_vector = {arg_val.getValue().get(),
+                                                  column_values.getValue().get(),
+                                                  converted.get()}});
+}
+}  // namespace
+
 // LowerStringOper: LOWER
 std::shared_ptr<Analyzer::Expr> LowerStringOper::deep_copy() const {
   return makeExpr<Analyzer::LowerStringOper>(
@@ -371,6 +389,11 @@ JITExprValue& LowerStringOper::codegen(CodegenContext& context) {
   CHECK(arg->get_type_info().is_string());
   auto arg_val = VarSizeJITExprValue(arg->codegen(context));
 
+  if (auto converted = codegenCaseConvertedColumn(context, arg, arg_val, false);
+      converted.get()) {
+    return set_expr_value(arg_val.getNull(), arg_val.getLength(), converted);
+  }
+
   // get string heap ptr
   auto string_heap_ptr = func.emitRuntimeFunctionCall(
       "get_query_context_string_heap_ptr",
@@ -412,6 +435,11 @@ JITExprValue& UpperStringOper::codegen(CodegenContext& context) {
   CHECK(arg->get_type_info().is_string());
   auto arg_val = VarSizeJITExprValue(arg->codegen(context));
 
+  if (auto converted = codegenCaseConvertedColumn(context, arg, arg_val, true);
+      converted.get()) {
+    return set_expr_value(arg_val.getNull(), arg_val.getLength(), converted);
+  }
+
   // get string heap ptr
   auto string_heap_ptr = func.emitRuntimeFunctionCall(
       "get_query_context_string_heap_ptr",
@@ -595,12 +623,6 @@ JITExprValue& TrimStringOper::codegen(CodegenContext& context) {
   std::string trim_char_val = *trim_char_literal->get_constval().stringval;
   int trim_char_map_idx = context.registerTrimStringOperCharMap(trim_char_val);
 
-  // get string heap ptr
-  auto string_heap_ptr = func.emitRuntimeFunctionCall(
-      "get_query_context_string_heap_ptr",
-      JITFunctionEmitDescriptor{.ret_type = JITTypeTag::POINTER,
-                                .ret_sub_type = JITTypeTag::INT8,
-                                .params_vector = {func.getArgument(0).get()}});
   // get runtime trim_char_map ptr
   auto trim_char_map_ptr = func.emitRuntimeFunctionCall(
       "get_query_context_trim_char_map_by_id",
@@ -621,8 +643,7 @@ JITExprValue& TrimStringOper::codegen(CodegenContext& context) {
       fn_name,
       JITFunctionEmitDescriptor{
           .ret_type = JITTypeTag::INT64,
-          .params_vector = {string_heap_ptr.get(),
-                            input_val.getValue().get(),
+          .params_vector = {input_val.getValue().get(),
                             input_val.getLength().get(),
                             trim_char_map_ptr.get(),
                             func.createLiteral<bool>(JITTypeTag::BOOL, do_ltrim).get(),
@@ -706,6 +727,31 @@ JITExprValue& SplitPartStringOper::codegen(CodegenContext& context) {
   return set_expr_value(input_val.getNull(), ret_len, ret_ptr);
 }
 
+namespace {
+// Emits the regex compiled at codegen time if the pattern is a literal, or the pattern
+// of the row compiled (and cached) by the runtime context.
+JITValuePointer codegenRegexPtr(CodegenContext& context,
+                                Analyzer::Expr* regex_pattern,
+                                VarSizeJITExprValue& regex_pattern_val) {
+  JITFunction& func = *context.getJITFunction();
+  auto regex_pattern_literal = dynamic_cast<Analyzer::Constant*>(regex_pattern);
+  int regex_idx = regex_pattern_literal
+                      ? context.registerRegex(
+                            *regex_pattern_literal->get_constval().stringval)
+                      : -1;
+  return func.emitRuntimeFunctionCall(
+      "get_query_context_regex",
+      JITFunctionEmitDescriptor{
+          .ret_type = JITTypeTag::POINTER,
+          .ret_sub_type = JITTypeTag::INT8,
+          .params_vector = {
+              func.getArgument(0).get(),
+              func.createLiteral<int32_t>(JITTypeTag::INT32, regex_idx).get(),
+              regex_pattern_val.getValue().get(),
+              regex_pattern_val.getLength().get()}});
+}
+}  // namespace
+
 std::shared_ptr<Analyzer::Expr> RegexpReplaceStringOper::deep_copy() const {
   return makeExpr<Analyzer::RegexpReplaceStringOper>(
       std::dynamic_pointer_cast<Analyzer::StringOper>(StringOper::deep_copy()));
@@ -720,8 +766,8 @@ JITExprValue& RegexpReplaceStringOper::codegen(CodegenContext& context) {
 
   auto input_val = VarSizeJITExprValue(input->codegen(context));
 
-  auto regex_pattern_literal = dynamic_cast<Analyzer::Constant*>(regex_pattern);
-  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern_literal->codegen(context));
+  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern->codegen(context));
+  auto regex_ptr = codegenRegexPtr(context, regex_pattern, regex_pattern_val);
 
   auto replace_literal = dynamic_cast<Analyzer::Constant*>(replace);
   auto replace_val = VarSizeJITExprValue(replace_literal->codegen(context));
@@ -746,8 +792,7 @@ JITExprValue& RegexpReplaceStringOper::codegen(CodegenContext& context) {
               string_heap_ptr.get(),
               input_val.getValue().get(),
               input_val.getLength().get(),
-              regex_pattern_val.getValue().get(),
-              regex_pattern_val.getLength().get(),
+              regex_ptr.get(),
               replace_val.getValue().get(),
               replace_val.getLength().get(),
               func.createLiteral<int>(JITTypeTag::INT32, start_pos_val).get(),
@@ -779,8 +824,8 @@ JITExprValue& RegexpExtractStringOper::codegen(CodegenContext& context) {
 
   auto input_val = VarSizeJITExprValue(input->codegen(context));
 
-  auto regex_pattern_literal = dynamic_cast<Analyzer::Constant*>(regex_pattern);
-  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern_literal->codegen(context));
+  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern->codegen(context));
+  auto regex_ptr = codegenRegexPtr(context, regex_pattern, regex_pattern_val);
 
   int group_val =
       dynamic_cast<const Analyzer::Constant*>(getArg(2))->get_constval().intval;
@@ -800,8 +845,7 @@ JITExprValue& RegexpExtractStringOper::codegen(CodegenContext& context) {
               string_heap_ptr.get(),
               input_val.getValue().get(),
               input_val.getLength().get(),
-              regex_pattern_val.getValue().get(),
-              regex_pattern_val.getLength().get(),
+              regex_ptr.get(),
               func.createLiteral<int>(JITTypeTag::INT32, group_val).get()}});
 
   // decode result
@@ -830,8 +874,8 @@ JITExprValue& RegexpSubstrStringOper::codegen(CodegenContext& context) {
 
   auto input_val = VarSizeJITExprValue(input->codegen(context));
 
-  auto regex_pattern_literal = dynamic_cast<Analyzer::Constant*>(regex_pattern);
-  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern_literal->codegen(context));
+  auto regex_pattern_val = VarSizeJITExprValue(regex_pattern->codegen(context));
+  auto regex_ptr = codegenRegexPtr(context, regex_pattern, regex_pattern_val);
 
   int start_pos_val =
       dynamic_cast<const Analyzer::Constant*>(getArg(2))->get_constval().intval;
@@ -853,8 +897,7 @@ JITExprValue& RegexpSubstrStringOper::codegen(CodegenContext& context) {
               string_heap_ptr.get(),
               input_val.getValue().get(),
               input_val.getLength().get(),
-              regex_pattern_val.getValue().get(),
-              regex_pattern_val.getLength().get(),
+              regex_ptr.get(),
               func.createLiteral<int>(JITTypeTag::INT32, occurence_val).get(),
               func.createLiteral<int>(JITTypeTag::INT32, start_pos_val).get()}});
 
@@ -0,0 +1,312 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "util/CiderCpuDispatch.h"
+
+#include <immintrin.h>
+#include <atomic>
+#include <cstring>
+#include <string_view>
+
+#include "type/data/funcannotations.h"
+#include "util/Logger.h"
+
+#define CIDER_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt,lzcnt")))
+#define CIDER_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi,bmi2,popcnt,lzcnt")))
+
+namespace CiderCpuDispatch {
+
+namespace {
+
+// ISA independent kernel bodies. They are force inlined into every ISA variant below,
+// so the compiler vectorizes and selects instructions for each target separately.
+FORCE_INLINE size_t countSetBitsImpl(const uint8_t* bit_vector, size_t end) {
+  size_t ans = 0;
+  size_t words = end >> 6;
+  for (size_t i = 0; i < words; ++i) {
+    uint64_t word;
+    std::memcpy(&word, bit_vector + (i << 3), sizeof(word));
+    ans += __builtin_popcountll(word);
+  }
+  for (size_t i = words << 6; i < end; ++i) {
+    ans += (bit_vector[i >> 3] >> (i & 0x7)) & 1;
+  }
+  return ans;
+}
+
+FORCE_INLINE void bitwiseAndImpl(uint8_t* __restrict output,
+                                 const uint8_t* __restrict a,
+                                 const uint8_t* __restrict b,
+                                 size_t bit_num) {
+  size_t len = (bit_num + 7) >> 3;
+  for (size_t i = 0; i < len; ++i) {
+    output[i] = a[i] & b[i];
+  }
+}
+
+FORCE_INLINE void asciiLowerImpl(char* __restrict dst,
+                                 const char* __restrict src,
+                                 size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    uint8_t c = src[i];
+    dst[i] = c | (static_cast<uint8_t>(c - 'A') < 26 ? 0x20 : 0);
+  }
+}
+
+FORCE_INLINE void asciiUpperImpl(char* __restrict dst,
+                                 const char* __restrict src,
+                                 size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    uint8_t c = src[i];
+    dst[i] = c & ~(static_cast<uint8_t>(c - 'a') < 26 ? 0x20 : 0);
+  }
+}
+
+FORCE_INLINE int64_t findStrScalar(const char* str,
+                                   size_t str_len,
+                                   const char* pattern,
+                                   size_t pattern_len,
+                                   size_t from = 0) {
+  auto pos = std::string_view(str, str_len)
+                 .find(std::string_view(pattern, pattern_len), from);
+  return pos == std::string_view::npos ? -1 : static_cast<int64_t>(pos);
+}
+
+// Baseline variants.
+size_t countSetBitsBaseline(const uint8_t* bit_vector, size_t end) {
+  return countSetBitsImpl(bit_vector, end);
+}
+
+void bitwiseAndBaseline(uint8_t* output,
+                        const uint8_t* a,
+                        const uint8_t* b,
+                        size_t bit_num) {
+  bitwiseAndImpl(output, a, b, bit_num);
+}
+
+int64_t findStrBaseline(const char* str,
+                        size_t str_len,
+                        const char* pattern,
+                        size_t pattern_len) {
+  return findStrScalar(str, str_len, pattern, pattern_len);
+}
+
+void asciiLowerBaseline(char* dst, const char* src, size_t len) {
+  asciiLowerImpl(dst, src, len);
+}
+
+void asciiUpperBaseline(char* dst, const char* src, size_t len) {
+  asciiUpperImpl(dst, src, len);
+}
+
+// AVX2 variants.
+CIDER_TARGET_AVX2 size_t countSetBitsAVX2(const uint8_t* bit_vector, size_t end) {
+  return countSetBitsImpl(bit_vector, end);
+}
+
+CIDER_TARGET_AVX2 void bitwiseAndAVX2(uint8_t* output,
+                                      const uint8_t* a,
+                                      const uint8_t* b,
+                                      size_t bit_num) {
+  bitwiseAndImpl(output, a, b, bit_num);
+}
+
+// Compares the first and the last byte of pattern against 32 candidate positions at
+// once, only positions matching both are verified with memcmp.
+CIDER_TARGET_AVX2 int64_t findStrAVX2(const char* str,
+                                      size_t str_len,
+                                      const char* pattern,
+                                      size_t pattern_len) {
+  if (pattern_len == 0) {
+    return 0;
+  }
+  if (str_len < pattern_len) {
+    return -1;
+  }
+  const __m256i first = _mm256_set1_epi8(pattern[0]);
+  const __m256i last = _mm256_set1_epi8(pattern[pattern_len - 1]);
+  size_t i = 0;
+  for (; i + pattern_len + 31 <= str_len; i += 32) {
+    const __m256i block_first =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+    const __m256i block_last =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i + pattern_len - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)));
+    while (mask) {
+      size_t pos = i + __builtin_ctz(mask);
+      if (pattern_len <= 2 ||
+          std::memcmp(str + pos + 1, pattern + 1, pattern_len - 2) == 0) {
+        return pos;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return findStrScalar(str, str_len, pattern, pattern_len, i);
+}
+
+CIDER_TARGET_AVX2 void asciiLowerAVX2(char* dst, const char* src, size_t len) {
+  asciiLowerImpl(dst, src, len);
+}
+
+CIDER_TARGET_AVX2 void asciiUpperAVX2(char* dst, const char* src, size_t len) {
+  asciiUpperImpl(dst, src, len);
+}
+
+// AVX512 variants.
+CIDER_TARGET_AVX512 size_t countSetBitsAVX512(const uint8_t* bit_vector, size_t end) {
+  return countSetBitsImpl(bit_vector, end);
+}
+
+CIDER_TARGET_AVX512 void bitwiseAndAVX512(uint8_t* output,
+                                          const uint8_t* a,
+                                          const uint8_t* b,
+                                          size_t bit_num) {
+  bitwiseAndImpl(output, a, b, bit_num);
+}
+
+CIDER_TARGET_AVX512 int64_t findStrAVX512(const char* str,
+                                          size_t str_len,
+                                          const char* pattern,
+                                          size_t pattern_len) {
+  if (pattern_len == 0) {
+    return 0;
+  }
+  if (str_len < pattern_len) {
+    return -1;
+  }
+  const __m512i first = _mm512_set1_epi8(pattern[0]);
+  const __m512i last = _mm512_set1_epi8(pattern[pattern_len - 1]);
+  size_t i = 0;
+  for (; i + pattern_len + 63 <= str_len; i += 64) {
+    const __m512i block_first = _mm512_loadu_si512(str + i);
+    const __m512i block_last = _mm512_loadu_si512(str + i + pattern_len - 1);
+    uint64_t mask = _mm512_cmpeq_epi8_mask(first, block_first) &
+                    _mm512_cmpeq_epi8_mask(last, block_last);
+    while (mask) {
+      size_t pos = i + __builtin_ctzll(mask);
+      if (pattern_len <= 2 ||
+          std::memcmp(str + pos + 1, pattern + 1, pattern_len - 2) == 0) {
+        return pos;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return findStrScalar(str, str_len, pattern, pattern_len, i);
+}
+
+CIDER_TARGET_AVX512 void asciiLowerAVX512(char* dst, const char* src, size_t len) {
+  asciiLowerImpl(dst, src, len);
+}
+
+CIDER_TARGET_AVX512 void asciiUpperAVX512(char* dst, const char* src, size_t len) {
+  asciiUpperImpl(dst, src, len);
+}
+
+const Kernels kBaselineKernels{IsaLevel::kBaseline,
+                               countSetBitsBaseline,
+                               bitwiseAndBaseline,
+                               findStrBaseline,
+                               asciiLowerBaseline,
+                               asciiUpperBaseline};
+
+const Kernels kAVX2Kernels{IsaLevel::kAVX2,
+                           countSetBitsAVX2,
+                           bitwiseAndAVX2,
+                           findStrAVX2,
+                           asciiLowerAVX2,
+                           asciiUpperAVX2};
+
+const Kernels kAVX512Kernels{IsaLevel::kAVX512,
+                             countSetBitsAVX512,
+                             bitwiseAndAVX512,
+                             findStrAVX512,
+                             asciiLowerAVX512,
+                             asciiUpperAVX512};
+
+IsaLevel detectHostIsaLevel() {
+  __builtin_cpu_init();
+  bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+              __builtin_cpu_supports("popcnt");
+  if (avx2 && __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) {
+    return IsaLevel::kAVX512;
+  }
+  return avx2 ? IsaLevel::kAVX2 : IsaLevel::kBaseline;
+}
+
+std::atomic<IsaLevel>& selectedIsaLevel() {
+  static std::atomic<IsaLevel> level{getHostIsaLevel()};
+  return level;
+}
+
+}  // namespace
+
+IsaLevel getHostIsaLevel() {
+  static const IsaLevel host_level = []() {
+    auto level = detectHostIsaLevel();
+    LOG(INFO) << "Host ISA level for runtime kernels: " << toString(level);
+    return level;
+  }();
+  return host_level;
+}
+
+IsaLevel getIsaLevel() {
+  return selectedIsaLevel().load(std::memory_order_relaxed);
+}
+
+void setIsaLevel(IsaLevel level) {
+  if (level > getHostIsaLevel()) {
+    LOG(WARNING) << "ISA level " << toString(level)
+                 << " is not supported by host, fallback to "
+                 << toString(getHostIsaLevel());
+    level = getHostIsaLevel();
+  }
+  selectedIsaLevel().store(level, std::memory_order_relaxed);
+}
+
+const char* toString(IsaLevel level) {
+  switch (level) {
+    case IsaLevel::kBaseline:
+      return "baseline";
+    case IsaLevel::kAVX2:
+      return "avx2";
+    case IsaLevel::kAVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+const Kernels& getKernels(IsaLevel level) {
+  CHECK(level <= getHostIsaLevel()) << "ISA level " << toString(level)
+                                    << " is not supported by host.";
+  switch (level) {
+    case IsaLevel::kAVX512:
+      return kAVX512Kernels;
+    case IsaLevel::kAVX2:
+      return kAVX2Kernels;
+    default:
+      return kBaselineKernels;
+  }
+}
+
+}  // namespace CiderCpuDispatch
@@ -0,0 +1,78 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CIDER_UTIL_CIDERCPUDISPATCH_H
+#define CIDER_UTIL_CIDERCPUDISPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Native runtime kernels compiled for several x86 ISA levels. The level used by
+// getKernels() is detected from host CPU features once at process start.
+// These are for natively compiled callers. Runtime functions inlined into JIT code
+// keep their plain loops, which LLVM vectorizes for the JIT target itself.
+namespace CiderCpuDispatch {
+
+enum class IsaLevel : int8_t {
+  kBaseline = 0,  // x86-64 baseline, SSE2 only
+  kAVX2 = 1,      // AVX2, BMI2, POPCNT (Haswell, Zen)
+  kAVX512 = 2,    // AVX512F/BW/VL (Skylake-SP, Ice Lake)
+};
+
+struct Kernels {
+  IsaLevel level;
+  // Number of set bits in the first `end` bits of bit_vector.
+  size_t (*count_set_bits)(const uint8_t* bit_vector, size_t end);
+  void (*bitwise_and)(uint8_t* output,
+                      const uint8_t* a,
+                      const uint8_t* b,
+                      size_t bit_num);
+  // Position of the first occurrence of pattern in str, -1 if not found.
+  int64_t (*find_str)(const char* str,
+                      size_t str_len,
+                      const char* pattern,
+                      size_t pattern_len);
+  // ASCII case conversion of len bytes, other bytes are copied as is.
+  void (*ascii_lower)(char* dst, const char* src, size_t len);
+  void (*ascii_upper)(char* dst, const char* src, size_t len);
+};
+
+// Highest ISA level supported by the host CPU.
+IsaLevel getHostIsaLevel();
+
+// ISA level of kernels returned by getKernels() and the default for JIT code.
+IsaLevel getIsaLevel();
+
+// Overrides the selected ISA level, clamped to the host ISA level.
+void setIsaLevel(IsaLevel level);
+
+const char* toString(IsaLevel level);
+
+// Returns kernels compiled for `level`, which must not exceed the host ISA level.
+const Kernels& getKernels(IsaLevel level);
+
+inline const Kernels& getKernels() {
+  return getKernels(getIsaLevel());
+}
+
+}  // namespace CiderCpuDispatch
+
+#endif  // CIDER_UTIL_CIDERCPUDISPATCH_H
@@ -67,17 +67,6 @@ constexpr std::array<std::string_view, 13> month_suffixes{
 constexpr unsigned
     pow_10[10]{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
-// Return y-m-d minus 1970-01-01 in days according to Gregorian calendar.
-// Credit: http://howardhinnant.github.io/date_algorithms.html#days_from_civil
-int64_t daysFromCivil(int64_t y, unsigned const m, unsigned const d) {
-  y -= m <= 2;
-  int64_t const era = (y < 0 ? y - 399 : y) / 400;
-  unsigned const yoe = static_cast<unsigned>(y - era * 400);             // [0, 399]
-  unsigned const doy = (153 * (m + (m <= 2 ? 9 : -3)) + 2) / 5 + d - 1;  // [0, 365]
-  unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
-  return era * 146097 + static_cast<int64_t>(doe) - 719468;
-}
-
 // Order of entries correspond to enum class FormatType { Date, Time, Timezone }.
 std::vector<std::vector<std::string_view>> formatViews() {
   return {{{"%Y-%m-%d", "%m/%d/%y", "%m/%d/%Y", "%Y/%m/%d", "%d-%b-%y", "%d/%b/%Y"},
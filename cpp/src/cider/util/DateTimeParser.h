@@ -53,6 +53,102 @@ int64_t dateTimeParse(std::string_view const s, unsigned const dim) {
 
 int32_t parseDateInDays(std::string_view);
 
+// Return y-m-d minus 1970-01-01 in days according to Gregorian calendar.
+// Credit: http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+inline int64_t daysFromCivil(int64_t y, unsigned const m, unsigned const d) {
+  y -= m <= 2;
+  int64_t const era = (y < 0 ? y - 399 : y) / 400;
+  unsigned const yoe = static_cast<unsigned>(y - era * 400);             // [0, 399]
+  unsigned const doy = (153 * (m + (m <= 2 ? 9 : -3)) + 2) / 5 + d - 1;  // [0, 365]
+  unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+/**
+ * Fixed-format fast paths for ISO strings, used ahead of the general parser on hot
+ * casts. Digits are validated and converted without branching per character, nothing
+ * is allocated. Each returns std::nullopt for any string outside its exact format,
+ * callers then fall back to the general parser which gives the same result for every
+ * string accepted here.
+ */
+namespace iso_datetime {
+
+// Value of the n ASCII digits at str, or -1 if any of them is not a digit.
+template <size_t n>
+inline int64_t digits(const char* str) {
+  int64_t value = 0;
+  unsigned invalid = 0;
+  for (size_t i = 0; i < n; ++i) {
+    unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+    invalid |= digit > 9;
+    value = value * 10 + digit;
+  }
+  return invalid ? -1 : value;
+}
+
+// "YYYY-MM-DD" prefix in days since epoch, trailing characters are ignored like in
+// parseDateInDays.
+inline std::optional<int64_t> parseDateInDays(std::string_view str) {
+  if (str.size() < 10 || str[4] != '-' || str[7] != '-') {
+    return std::nullopt;
+  }
+  int64_t year = digits<4>(str.data());
+  int64_t month = digits<2>(str.data() + 5);
+  int64_t day = digits<2>(str.data() + 8);
+  if ((year | month | day) < 0 || month < 1 || month > 12 || day < 1 || day > 31) {
+    return std::nullopt;
+  }
+  return daysFromCivil(year, month, day);
+}
+
+// "HH:MM:SS[.f{1,9}]" as the whole string, in (s,ms,us,ns) since midnight based on
+// dim in (0,3,6,9) respectively.
+inline std::optional<int64_t> parseTime(std::string_view str, unsigned const dim) {
+  constexpr int64_t pow_10[10]{
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  if (str.size() < 8 || str[2] != ':' || str[5] != ':' || str.size() == 9 ||
+      str.size() > 18 || (str.size() > 8 && str[8] != '.')) {
+    return std::nullopt;
+  }
+  int64_t hour = digits<2>(str.data());
+  int64_t minute = digits<2>(str.data() + 3);
+  int64_t second = digits<2>(str.data() + 6);
+  if ((hour | minute | second) < 0 || hour > 23 || minute > 59 || second > 61) {
+    return std::nullopt;
+  }
+  int64_t nanos = 0;
+  if (str.size() > 8) {
+    size_t len = str.size() - 9;
+    for (size_t i = 0; i < len; ++i) {
+      unsigned digit = static_cast<unsigned char>(str[9 + i]) - '0';
+      if (digit > 9) {
+        return std::nullopt;
+      }
+      nanos = nanos * 10 + digit;
+    }
+    nanos *= pow_10[9 - len];
+  }
+  return (3600 * hour + 60 * minute + second) * pow_10[dim] + nanos / pow_10[9 - dim];
+}
+
+// "YYYY-MM-DD[ T]HH:MM:SS[.f{1,9}]" as the whole string, in (s,ms,us,ns) since epoch
+// based on dim in (0,3,6,9) respectively.
+inline std::optional<int64_t> parseTimestamp(std::string_view str, unsigned const dim) {
+  constexpr int64_t pow_10[10]{
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  if (str.size() < 19 || (str[10] != ' ' && str[10] != 'T')) {
+    return std::nullopt;
+  }
+  auto days = parseDateInDays(str.substr(0, 10));
+  auto time = parseTime(str.substr(11), dim);
+  if (!days || !time) {
+    return std::nullopt;
+  }
+  return *days * kSecsPerDay * pow_10[dim] + *time;
+}
+
+}  // namespace iso_datetime
+
 /**
  * Set format_type_ and parse date/time/timestamp strings into (s,ms,us,ns) since the
  * epoch based on given dim in (0,3,6,9) respectively.  Basic idea is to parse given
@@ -0,0 +1,171 @@
+/*
+ * Copyright(c) 2022-2023 Intel Corporation.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "cider/CiderException.h"
+
+/**
+ * Conversions between decimal strings and numbers used by string casts. Nothing is
+ * allocated, strings are read from and written to caller provided buffers.
+ */
+namespace decimal_string {
+
+// Writes the decimal digits of value ending at buf_end, returns the number of chars.
+inline int32_t formatInt64(int64_t value, char* buf_end) {
+  static constexpr char kDigitPairs[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  uint64_t abs_value = value < 0 ? 0 - static_cast<uint64_t>(value) : value;
+  char* ptr = buf_end;
+  while (abs_value >= 100) {
+    ptr -= 2;
+    memcpy(ptr, kDigitPairs + (abs_value % 100) * 2, 2);
+    abs_value /= 100;
+  }
+  if (abs_value >= 10) {
+    ptr -= 2;
+    memcpy(ptr, kDigitPairs + abs_value * 2, 2);
+  } else {
+    *--ptr = '0' + abs_value;
+  }
+  if (value < 0) {
+    *--ptr = '-';
+  }
+  return buf_end - ptr;
+}
+
+// Returns whether the 8 chars loaded into chunk are all decimal digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Value of 8 decimal digits, first digit in the lowest byte.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+  chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+  return static_cast<uint32_t>((chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32);
+}
+
+// Parses the leading decimal integer of str like std::stoll: leading whitespace and a
+// sign are accepted, parsing stops at the first non-digit. Digits are converted eight
+// at a time with SWAR arithmetic, without building a std::string.
+inline int64_t parseInt64(const char* str, const int32_t len) {
+  int32_t i = 0;
+  while (i < len && isspace(str[i])) {
+    ++i;
+  }
+  bool negative = false;
+  if (i < len && (str[i] == '+' || str[i] == '-')) {
+    negative = str[i] == '-';
+    ++i;
+  }
+  int32_t digits_begin = i;
+  while (i < len && str[i] == '0') {
+    ++i;
+  }
+  // At most 19 significant digits fit in uint64_t without overflow.
+  int32_t significant_begin = i;
+  uint64_t value = 0;
+  uint64_t chunk;
+  while (i + 8 <= len && i - significant_begin <= 11 &&
+         (memcpy(&chunk, str + i, 8), isEightDigits(chunk))) {
+    value = value * 100000000 + parseEightDigits(chunk);
+    i += 8;
+  }
+  while (i < len && static_cast<unsigned>(str[i] - '0') <= 9) {
+    if (i - significant_begin >= 19) {
+      CIDER_THROW(CiderRuntimeException,
+                  "value is out of range when cast from string to integer");
+    }
+    value = value * 10 + (str[i] - '0');
+    ++i;
+  }
+  if (i == digits_begin) {
+    CIDER_THROW(CiderRuntimeException, "invalid integer when cast from string");
+  }
+  uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + negative;
+  if (value > limit) {
+    CIDER_THROW(CiderRuntimeException,
+                "value is out of range when cast from string to integer");
+  }
+  return negative ? 0 - value : value;
+}
+
+// Parses "[+-]digits[.digits]" filling the whole string. Returns false for any other
+// format, or if the value can't be computed exactly with a single division by a power
+// of ten, so the caller falls back to the standard library.
+template <typename T, uint64_t max_exact, int32_t max_scale>
+inline bool parseSimpleDecimal(const char* str, const int32_t len, T& result) {
+  constexpr T pow_10[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                       1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  int32_t i = 0;
+  bool negative = false;
+  if (i < len && (str[i] == '+' || str[i] == '-')) {
+    negative = str[i] == '-';
+    ++i;
+  }
+  uint64_t value = 0;
+  int32_t digits = 0;
+  int32_t scale = -1;
+  for (; i < len; ++i) {
+    unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+    if (digit <= 9) {
+      if (++digits > 19) {
+        return false;
+      }
+      value = value * 10 + digit;
+      scale += scale >= 0;
+    } else if (str[i] == '.' && scale < 0) {
+      scale = 0;
+    } else {
+      return false;
+    }
+  }
+  scale = std::max(scale, 0);
+  if (digits == 0 || value > max_exact || scale > max_scale) {
+    return false;
+  }
+  result = static_cast<T>(value) / pow_10[scale];
+  result = negative ? -result : result;
+  return true;
+}
+
+// Float and double instances of parseSimpleDecimal. Values up to 2^24 (2^53) and
+// powers of ten up to 1e10 (1e22) are exact in float (double).
+inline bool parseSimpleFloat(const char* str, const int32_t len, float& result) {
+  return parseSimpleDecimal<float, (1ULL << 24), 10>(str, len, result);
+}
+
+inline bool parseSimpleDouble(const char* str, const int32_t len, double& result) {
+  return parseSimpleDecimal<double, (1ULL << 53), 22>(str, len, result);
+}
+
+}  // namespace decimal_string